@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+
+// Traversal of a list whose nodes are linked in random order, so that
+// almost every step touches another page: the arena with huge pages needs
+// fewer TLB entries than the heap or the arena with regular pages
+
+#include "../forward_list2.hpp"
+#include "../forward_list2_arena.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+template<typename List>
+void shuffle(List& list)
+{
+    std::mt19937 random(1);
+    list.sort_by_key([&random](int) { return random(); });
+}
+
+template<typename List>
+double traverse(const List& list, std::size_t count)
+{
+    auto start = std::chrono::steady_clock::now();
+    long sum = 0;
+    for (int i : list)
+        sum += i;
+    std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+    return sum == long(count) * (long(count) - 1) / 2 ? time.count() / count : -1;
+}
+
+template<typename List>
+double measure(List& list, std::size_t count)
+{
+    int i = 0;
+    list.generate_back(count, [&i]() { return i++; });
+    shuffle(list);
+    return traverse(list, count);
+}
+
+const char* name(forward_list2_arena::backing b)
+{
+    switch (b) {
+    case forward_list2_arena::backing::hugetlb:                return "MAP_HUGETLB";
+    case forward_list2_arena::backing::transparent_huge_pages: return "MADV_HUGEPAGE";
+    case forward_list2_arena::backing::pages:                  return "regular pages";
+    default:                                                   return "operator new";
+    }
+}
+
+void arena(std::size_t count, bool huge_pages)
+{
+    forward_list2_arena_options options;
+    options.huge_pages = huge_pages;
+    forward_list2_arena arena(options);
+    forward_list2<int, forward_list2_arena_allocator<int>> list((forward_list2_arena_allocator<int>(arena)));
+    auto ns = measure(list, count);
+
+    auto backing = forward_list2_arena::backing::heap;
+    for (auto b : { forward_list2_arena::backing::hugetlb, forward_list2_arena::backing::transparent_huge_pages, forward_list2_arena::backing::pages })
+        if (arena.chunks(b) > 0) {
+            backing = b;
+            break;
+        }
+    std::printf("%9zu nodes, arena with %-14s %6.1f ns/node\n", count, name(backing), ns);
+}
+
+int main()
+{
+    for (std::size_t count : { 1u << 16, 1u << 20, 1u << 23 }) {
+        forward_list2<int> list;
+        std::printf("%9zu nodes, std::allocator           %6.1f ns/node\n", count, measure(list, count));
+        arena(count, false);
+        arena(count, true);
+    }
+}
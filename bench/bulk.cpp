@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+
+// Appending many nodes: emplace_back_n and generate_back construct the
+// elements in place without looking up the tail again, but they allocate
+// the nodes one by one as std::forward_list does, so there is no gain from
+// bulk allocation. The arena allocator is measured for comparison.
+
+#include "../forward_list2.hpp"
+#include "../forward_list2_arena.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <forward_list>
+#include <string>
+
+volatile long sink;
+
+template<typename Function>
+void measure(const char* name, std::size_t count, Function f)
+{
+    auto start = std::chrono::steady_clock::now();
+    sink = f();
+    std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+    std::printf("%-34s %9zu: %6.1f ns/element\n", name, count, time.count() / count);
+}
+
+template<typename List>
+long sum(const List& list)
+{
+    long result = 0;
+    for (const auto& s : list)
+        result += s.size();
+    return result;
+}
+
+void append(std::size_t count)
+{
+    using string_list = forward_list2<std::string>;
+
+    measure("std::forward_list insert_after", count, [count]() {
+        std::forward_list<std::string> list;
+        auto it = list.before_begin();
+        for (std::size_t i = 0; i < count; ++i)
+            it = list.insert_after(it, std::string(20, 'x'));
+        return sum(list);
+    });
+
+    measure("forward_list2 push_back", count, [count]() {
+        string_list list;
+        for (std::size_t i = 0; i < count; ++i)
+            list.push_back(std::string(20, 'x'));
+        return sum(list);
+    });
+
+    measure("forward_list2 emplace_back_n", count, [count]() {
+        string_list list;
+        list.emplace_back_n(count, 20, 'x');
+        return sum(list);
+    });
+
+    measure("forward_list2 generate_back", count, [count]() {
+        string_list list;
+        list.generate_back(count, []() { return std::string(20, 'x'); });
+        return sum(list);
+    });
+
+    measure("forward_list2 arena emplace_back_n", count, [count]() {
+        forward_list2_arena_options options;
+        options.huge_pages = false;
+        forward_list2_arena arena(options);
+        using allocator = forward_list2_arena_allocator<std::string>;
+        forward_list2<std::string, allocator> list((allocator(arena)));
+        list.emplace_back_n(count, 20, 'x');
+        return sum(list);
+    });
+}
+
+int main()
+{
+    for (std::size_t count : { 1000, 100000, 10000000 })
+        append(count);
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+
+// Compares std::queue over forward_list2 with std::queue over std::deque
+
+#include "../forward_list2_queue.hpp"
+#include "../forward_list2_tracking_allocator.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <queue>
+#include <vector>
+
+template<typename Queue>
+using container_of = typename Queue::container_type;
+
+template<typename Queue>
+const char* name() { return "forward_list2"; }
+
+template<>
+const char* name<std::queue<int>>() { return "deque"; }
+
+template<typename Function>
+double measure(Function f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+    return time.count();
+}
+
+volatile long sink;
+
+// Fills the queue and then drains it
+template<typename Queue>
+void push_heavy(int count)
+{
+    auto ns = measure([count]() {
+        Queue q;
+        for (int i = 0; i < count; ++i)
+            q.push(i);
+        long sum = 0;
+        while (!q.empty()) {
+            sum += q.front();
+            q.pop();
+        }
+        sink = sum;
+    });
+    std::printf("%-14s push-heavy %8d: %6.1f ns/element\n", name<Queue>(), count, ns / count);
+}
+
+// Keeps the queue at the same depth, every push is followed by a pop
+template<typename Queue>
+void pop_heavy(int depth, int count)
+{
+    Queue q;
+    for (int i = 0; i < depth; ++i)
+        q.push(i);
+
+    auto ns = measure([&q, count]() {
+        long sum = 0;
+        for (int i = 0; i < count; ++i) {
+            q.push(i);
+            sum += q.front();
+            q.pop();
+        }
+        sink = sum;
+    });
+    std::printf("%-14s pop-heavy  %8d: %6.1f ns/element\n", name<Queue>(), depth, ns / count);
+}
+
+struct deque_tag;
+struct list_tag;
+
+// Heap footprint of many short queues
+template<typename Queue, typename Tag>
+void footprint(int queues, int depth)
+{
+    {
+        std::vector<Queue> q(queues);
+        for (auto& e : q)
+            for (int i = 0; i < depth; ++i)
+                e.push(i);
+
+        auto& stats = forward_list2_tag_stats<Tag>();
+        std::printf("%-14s footprint  %8d: %6.1f bytes/element\n", name<Queue>(), depth,
+                    double(stats.live_footprint()) / queues / depth);
+    }
+}
+
+using tracked_deque = std::queue<int, std::deque<int, forward_list2_tracking_allocator<int, std::allocator<int>, deque_tag>>>;
+using tracked_list  = forward_list2_queue<int, forward_list2_tracking_allocator<int, std::allocator<int>, list_tag>>;
+
+template<>
+const char* name<tracked_deque>() { return "deque"; }
+
+int main()
+{
+    for (int count : { 1000, 100000, 10000000 }) {
+        push_heavy<std::queue<int>>(count);
+        push_heavy<forward_list2_queue<int>>(count);
+    }
+
+    for (int depth : { 1, 64, 100000 }) {
+        pop_heavy<std::queue<int>>(depth, 10000000);
+        pop_heavy<forward_list2_queue<int>>(depth, 10000000);
+    }
+
+    for (int depth : { 1, 16, 1024 }) {
+        footprint<tracked_deque, deque_tag>(1000, depth);
+        footprint<tracked_list, list_tag>(1000, depth);
+    }
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+
+// Compares spsc_forward_list2 with forward_list2 under a mutex
+// for one producer and one consumer thread
+
+#include "../forward_list2_spsc.hpp"
+#include "../forward_list2.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class locked_forward_list2
+{
+public:
+    void push_back(long value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_list.push_back(value);
+    }
+
+    bool try_pop(long& value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_list.empty())
+            return false;
+        value = m_list.front();
+        m_list.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex          m_mutex;
+    forward_list2<long> m_list;
+};
+
+template<typename Queue>
+long pop(Queue& q)
+{
+    long value;
+    while (!q.try_pop(value))
+        std::this_thread::yield();
+    return value;
+}
+
+template<typename Queue>
+double throughput(long count)
+{
+    Queue q;
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&q, count]() {
+        for (long i = 0; i < count; ++i)
+            q.push_back(i);
+    });
+
+    long sum = 0;
+    for (long i = 0; i < count; ++i)
+        sum += pop(q);
+    producer.join();
+
+    std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+    return sum == count * (count - 1) / 2 ? time.count() / count : -1;
+}
+
+// Round trip through two queues, returns the median in nanoseconds
+template<typename Queue>
+double latency(int count)
+{
+    Queue ping, pong;
+    std::thread echo([&ping, &pong, count]() {
+        for (int i = 0; i < count; ++i)
+            pong.push_back(pop(ping));
+    });
+
+    std::vector<double> times;
+    times.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        ping.push_back(i);
+        pop(pong);
+        std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+        times.push_back(time.count());
+    }
+    echo.join();
+
+    std::nth_element(times.begin(), times.begin() + count / 2, times.end());
+    return times[count / 2];
+}
+
+int main()
+{
+    const long count = 10000000;
+    std::printf("throughput: mutex %6.1f ns/element, spsc %6.1f ns/element\n",
+                throughput<locked_forward_list2>(count), throughput<spsc_forward_list2<long>>(count));
+
+    const int round_trips = 100000;
+    std::printf("round trip: mutex %6.0f ns, spsc %6.0f ns\n",
+                latency<locked_forward_list2>(round_trips), latency<spsc_forward_list2<long>>(round_trips));
+}
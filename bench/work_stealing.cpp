@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+
+// Compares work_stealing_forward_list2 with one forward_list2 under a mutex
+
+#include "../forward_list2_work_stealing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Single queue shared by all the workers
+class locked_forward_list2
+{
+public:
+    explicit locked_forward_list2(std::size_t) { }
+
+    void push_back(std::size_t, int value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_list.push_back(value);
+    }
+
+    bool try_pop(std::size_t, int& value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_list.empty())
+            return false;
+        value = m_list.front();
+        m_list.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex          m_mutex;
+    forward_list2<int> m_list;
+};
+
+volatile unsigned sink;
+
+// Task of the given cost, as a number of dependent multiplications
+unsigned work(int value, int cost)
+{
+    unsigned x = value;
+    for (int i = 0; i < cost; ++i)
+        x = x * 2654435761u + 1;
+    return x;
+}
+
+// All the tasks are pushed by worker 0, every task spawns a child on its
+// worker until the depth is reached, so the load has to be redistributed
+template<typename Queues>
+double run(std::size_t threads, int tasks, int depth, int cost)
+{
+    Queues queues(threads);
+    for (int i = 0; i < tasks; ++i)
+        queues.push_back(0, depth);
+
+    std::atomic<long> pending{ long(tasks) * (depth + 1) };
+    auto worker = [&](std::size_t id) {
+        unsigned local = 0;
+        int value;
+        while (pending.load(std::memory_order_relaxed) > 0) {
+            if (!queues.try_pop(id, value)) {
+                std::this_thread::yield();
+                continue;
+            }
+            local += work(value, cost);
+            if (value > 0)
+                queues.push_back(id, value - 1);
+            pending.fetch_sub(1, std::memory_order_relaxed);
+        }
+        sink = local;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < threads; ++i)
+        workers.emplace_back(worker, i);
+    worker(0);
+    for (auto& w : workers)
+        w.join();
+
+    std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+    return time.count();
+}
+
+int main()
+{
+    const int tasks = 100000;
+    const int depth = 9;
+    const std::size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int cost : { 0, 100, 1000 }) {
+        for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+            auto locked = run<locked_forward_list2>(threads, tasks, depth, cost);
+            auto stealing = run<work_stealing_forward_list2<int>>(threads, tasks, depth, cost);
+            std::printf("cost %4d, %2zu threads: mutex %8.1f ms, work stealing %8.1f ms\n",
+                        cost, threads, locked, stealing);
+        }
+    }
+}
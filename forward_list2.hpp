@@ -23,8 +23,36 @@
 #ifndef FORWARD_LIST_2_HPP
 #define FORWARD_LIST_2_HPP
 
+#include <algorithm>
 #include <forward_list>
 #include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Define to 1 to skip the tail walks after copy assignment and sorting.
+// The tail is then found on the first before_end(), back() or push_back(),
+// or by the next traversal which reaches the end of the list.
+// The macros below change the inline member functions, so every translation
+// unit of a program must see the same definitions, e.g. set by the build
+// system; mixing them violates the one definition rule.
+#ifndef FORWARD_LIST2_LAZY_LAST
+#define FORWARD_LIST2_LAZY_LAST 0
+#endif
+
+// Instrumentation hook for the tests, called on each node visited while
+// walking to the tail. Not meant to be defined by users.
+#ifndef FORWARD_LIST2_ON_TAIL_WALK_STEP
+#define FORWARD_LIST2_ON_TAIL_WALK_STEP()
+#endif
+
+// Tag to sort the list as an array of nodes, which is faster for lists
+// much larger than the cache. Unlike the default sort, it is not stable.
+struct forward_list2_array_sort_t { };
+constexpr forward_list2_array_sort_t forward_list2_array_sort{};
 
 template<typename T, class Allocator = std::allocator<T>>
 class forward_list2
@@ -42,6 +70,8 @@ public:
     using iterator        = typename Base::iterator;
     using const_iterator  = typename Base::const_iterator;
 
+    class sort_buffer;
+
     forward_list2() :
         m_list()
     {
@@ -54,6 +84,12 @@ public:
         adjust_last_iterator_on_clear();
     }
 
+    explicit forward_list2(size_type count, const Allocator& alloc = Allocator()) :
+        forward_list2(alloc)
+    {
+        emplace_back_n(count);
+    }
+
     forward_list2(size_type count, const T& value, const Allocator& alloc = Allocator()) :
         forward_list2(alloc)
     {
@@ -80,8 +116,9 @@ public:
     }
 
     forward_list2(forward_list2&& other) :
-        m_list(std::move(other.m_list)), m_last(std::move(other.m_last))
+        m_list(std::move(other.m_list))
     {
+        adjust_last_iterator_on_move(other.m_last);
         other.adjust_last_iterator_on_clear();
     }
 
@@ -105,7 +142,7 @@ public:
     forward_list2& operator=(const forward_list2& other)
     {
         m_list = other.m_list;
-        adjust_last_iterator_linear_time();
+        adjust_last_iterator_on_reorder();
         return *this;
     }
 
@@ -115,7 +152,7 @@ public:
 #endif
     {
         m_list = std::move(other.m_list);
-        m_last = other.m_last;
+        adjust_last_iterator_on_move(other.m_last);
         other.adjust_last_iterator_on_clear();
         return *this;
     }
@@ -151,7 +188,8 @@ public:
     const_reference front() const { return *begin(); }
 
     // New!
-//    reference back()             { return *before_end(); }
+    // The element itself is not const, only the iterator to it is
+    reference back()             { return const_cast<reference>(*before_end()); }
     const_reference back() const { return *before_end(); }
 
     iterator before_begin()              noexcept { return m_list.before_begin(); }
@@ -164,8 +202,8 @@ public:
 
     // New!
 //    iterator before_end()              noexcept { return m_last; }
-    const_iterator before_end()  const noexcept { return m_last; }
-    const_iterator cbefore_end() const noexcept { return m_last; }
+    const_iterator before_end()  const noexcept { return resolve_last_iterator(); }
+    const_iterator cbefore_end() const noexcept { return resolve_last_iterator(); }
 
     iterator end()              noexcept { return m_list.end(); }
     const_iterator end()  const noexcept { return m_list.end(); }
@@ -180,6 +218,15 @@ public:
         adjust_last_iterator_on_clear();
     }
 
+    // New!
+    // Destroys up to budget elements from the front, returns true when the list is empty
+    bool clear_incremental(size_type budget)
+    {
+        for (; budget > 0 && !empty(); --budget)
+            pop_front();
+        return empty();
+    }
+
     iterator insert_after(const_iterator pos, const T& value)
     {
         auto last_pos = m_list.insert_after(pos, value);
@@ -245,30 +292,41 @@ public:
     template<class... Args>
     reference emplace_back(Args&&... args) { return *emplace_after(before_end(), std::forward<Args>(args)...); }
 
+    // New!
+    template<class... Args>
+    void emplace_back_n(size_type count, const Args&... args)
+    {
+        for (auto it = before_end(); count > 0; --count)
+            it = emplace_after(it, args...);
+    }
+
+    // New!
+    template<class Generator>
+    void generate_back(size_type count, Generator gen)
+    {
+        for (auto it = before_end(); count > 0; --count)
+            it = emplace_after(it, gen());
+    }
+
     void pop_front() { erase_after(before_begin()); }
     
     void resize(size_type count, const T& value)
     {
-        auto it = before_begin();
-        for (size_type i = 0; i < count; ++i, ++it) {
-            if (it == before_end()) {
-                insert_after(it, count - i, value);
-                return;
-            }
-        }
-
-        erase_after(it, end());
+        insert_after(before_end(), truncate(count), value);
     }
 
     void resize(size_type count)
     {
-        resize(count, T{});
+        // Elements are value-initialized in place, no temporary is copied
+        emplace_back_n(truncate(count));
     }
 
     void swap(forward_list2& other) noexcept
     {
         std::swap(m_list, other.m_list);
         std::swap(m_last, other.m_last);
+        adjust_last_iterator_on_move(m_last);
+        other.adjust_last_iterator_on_move(other.m_last);
     }
 
     void merge(forward_list2& other)  { merge(other, std::less<T>()); }
@@ -281,16 +339,98 @@ public:
     void merge(forward_list2& other, Compare comp)
     {
         // Standard does not require this, so do it explicitly
-        if (std::addressof(other) == this)
+        if (std::addressof(other) == this || other.empty())
             return;
 
-        m_list.merge(other.m_list, comp);
-        adjust_last_iterator_on_merge(other.m_last);
-        other.adjust_last_iterator_on_clear();
+        // Lists which do not overlap are concatenated after one or two comparisons
+        if (empty() || !comp(other.front(), back())) {
+            splice_after(before_end(), other);
+        }
+        else if (comp(other.back(), front())) {
+            splice_after(before_begin(), other);
+        }
+        else {
+            m_list.merge(other.m_list, comp);
+            adjust_last_iterator_on_merge(other.m_last);
+            other.adjust_last_iterator_on_clear();
+        }
+    }
+
+    // New!
+    void set_union_into(forward_list2& other, forward_list2& result) { set_union_into(other, result, std::less<T>()); }
+
+    // Both sorted lists are consumed, the nodes are relinked to the end of result.
+    // The three lists must be different.
+    template<typename Compare>
+    void set_union_into(forward_list2& other, forward_list2& result, Compare c)
+    {
+        while (!empty() && !other.empty()) {
+            if (c(other.front(), front())) {
+                other.transfer_front(result);
+            }
+            else {
+                if (!c(front(), other.front()))
+                    other.pop_front();
+                transfer_front(result);
+            }
+        }
+        result.splice_after(result.before_end(), *this);
+        result.splice_after(result.before_end(), other);
+    }
+
+    // New!
+    void set_intersection_into(forward_list2& other, forward_list2& result) { set_intersection_into(other, result, std::less<T>()); }
+
+    template<typename Compare>
+    void set_intersection_into(forward_list2& other, forward_list2& result, Compare c)
+    {
+        while (!empty() && !other.empty()) {
+            if (c(front(), other.front())) {
+                pop_front();
+            }
+            else if (c(other.front(), front())) {
+                other.pop_front();
+            }
+            else {
+                other.pop_front();
+                transfer_front(result);
+            }
+        }
+        clear();
+        other.clear();
+    }
+
+    // New!
+    void set_difference_into(forward_list2& other, forward_list2& result) { set_difference_into(other, result, std::less<T>()); }
+
+    template<typename Compare>
+    void set_difference_into(forward_list2& other, forward_list2& result, Compare c)
+    {
+        while (!empty() && !other.empty()) {
+            if (c(front(), other.front())) {
+                transfer_front(result);
+            }
+            else {
+                if (!c(other.front(), front()))
+                    pop_front();
+                other.pop_front();
+            }
+        }
+        result.splice_after(result.before_end(), *this);
+        other.clear();
     }
 
     void splice_after(const_iterator pos, forward_list2& other)
     {
+        if (other.empty())
+            return;
+
+        // Unlike splicing, taking over the whole list does not walk it
+        if (empty() && pos == cbefore_begin()) {
+            swap(other);
+            return;
+        }
+
         adjust_last_iterator_on_insertion(pos, other.m_last);
         m_list.splice_after(pos, std::move(other.m_list));
         other.adjust_last_iterator_on_clear();
@@ -309,31 +449,141 @@ public:
             splice_after(pos, std::move(other), first);
     }
 
+    // New!
+    void rotate_front_to_back() { move_to_back(cbefore_begin()); }
+
+    // New!
+    void move_to_back(const_iterator pos)
+    {
+        auto it = std::next(pos);
+        if (it == cend())
+            return;
+
+        auto last = before_end();
+        if (it == last)
+            return;
+
+        m_list.splice_after(last, m_list, pos);
+        m_last = it;
+    }
+
+    // New!
+    // Makes std::next(pos) the first element, std::forward_list walks the elements up to pos
+    void rotate_after(const_iterator pos)
+    {
+        if (pos == cbefore_begin() || std::next(pos) == cend())
+            return;
+
+        m_list.splice_after(before_end(), m_list, cbefore_begin(), std::next(pos));
+        m_last = pos;
+    }
+
+    // New!
+    forward_list2 split_after(const_iterator pos)
+    {
+        forward_list2 result(get_allocator());
+        if (pos == cbefore_begin()) {
+            swap(result);
+        }
+        else if (pos != m_last) {
+            // Nodes are relinked without touching the elements
+            result.m_list.splice_after(result.cbefore_begin(), m_list, pos, cend());
+            result.m_last = m_last;
+            m_last = pos;
+        }
+        return result;
+    }
+
+    // New!
+    forward_list2 detach_front(size_type count)
+    {
+        auto last = cbefore_begin();
+        for (; count > 0 && std::next(last) != cend(); --count)
+            ++last;
+
+        return detach_front_until(last);
+    }
+
+    // New!
+    template<typename UnaryPredicate>
+    forward_list2 detach_front_while(UnaryPredicate p)
+    {
+        auto last = cbefore_begin();
+        while (std::next(last) != cend() && p(*std::next(last)))
+            ++last;
+
+        return detach_front_until(last);
+    }
+
     void splice_after(const_iterator pos, forward_list2&& other) { splice_after(pos, other); }
     void splice_after(const_iterator pos, forward_list2&& other, const_iterator it) { splice_after(pos, other, it); }
     void splice_after(const_iterator pos, forward_list2&& other, const_iterator first, const_iterator last) { splice_after(pos, other, first, last); }
 
     void remove(const T& value)
     {
-        for (auto it = before_begin(); it != before_end();) {
-            auto next = std::next(it);
+        auto it = before_begin();
+        for (auto next = begin(); next != end(); next = std::next(it)) {
             if (*next == value)
                 erase_after(it);
             else
                 it = next;
         }
+        m_last = it;
     }
 
     template<typename UnaryPredicate>
     void remove_if(UnaryPredicate p)
     {
-        for (auto it = before_begin(); it != before_end();) {
-            auto next = std::next(it);
+        auto it = before_begin();
+        for (auto next = begin(); next != end(); next = std::next(it)) {
             if (p(*next))
                 erase_after(it);
             else
                 it = next;
         }
+        m_last = it;
+    }
+
+    // New!
+    template<typename UnaryPredicate>
+    forward_list2 partition(UnaryPredicate p)
+    {
+        // Matching nodes are relinked to the new list one by one, no allocations
+        forward_list2 result(get_allocator());
+        auto it = before_begin();
+        while (std::next(it) != end()) {
+            if (p(*std::next(it)))
+                result.splice_after(result.before_end(), *this, it);
+            else
+                ++it;
+        }
+        m_last = it;
+        return result;
+    }
+
+    // New!
+    template<typename UnaryPredicate>
+    const_iterator stable_partition(UnaryPredicate p)
+    {
+        // Matching nodes are moved one by one after the last matching one,
+        // so each node is visited once
+        auto last_matched = cbefore_begin();
+        auto it = cbefore_begin();
+        while (std::next(it) != cend()) {
+            auto next = std::next(it);
+            if (!p(*next)) {
+                it = next;
+                continue;
+            }
+
+            if (it != last_matched)
+                m_list.splice_after(last_matched, m_list, it);
+            else
+                it = next;
+            last_matched = next;
+        }
+        m_last = it;
+        return last_matched;
     }
 
     void reverse() noexcept
@@ -347,13 +597,40 @@ public:
     template<typename BinaryPredicate>
     void unique(BinaryPredicate b)
     {
-        for (auto it = begin(); it != before_end();) {
-            auto next = std::next(it);
+        if (empty())
+            return;
+
+        auto it = begin();
+        for (auto next = std::next(it); next != end(); next = std::next(it)) {
             if (b(*next, *it))
                 erase_after(it);
             else
                 it = next;
         }
+        m_last = it;
+    }
+
+    // New!
+    size_type unique_unsorted() { return unique_unsorted(std::hash<T>(), std::equal_to<T>()); }
+
+    template<typename Hash, typename KeyEqual>
+    size_type unique_unsorted(Hash hash, KeyEqual eq)
+    {
+        // Keeps the first occurrences, the set refers to the kept elements
+        element_set<Hash, KeyEqual> kept(hash, eq);
+        size_type removed = 0;
+        auto it = before_begin();
+        for (auto next = begin(); next != end(); next = std::next(it)) {
+            if (kept.insert(*next)) {
+                it = next;
+            }
+            else {
+                erase_after(it);
+                ++removed;
+            }
+        }
+        m_last = it;
+        return removed;
     }
 
     void sort() { sort(std::less<T>()); }
@@ -361,10 +638,159 @@ public:
     template<typename Compare>
     void sort(Compare c)
     {
-        // It is compliant to standard since O(N log N) + O(N) => O(N log N)
-        // But I agree it is not the greatest implementation
-        m_list.sort(c);
-        adjust_last_iterator_linear_time();
+        if (empty())
+            return;
+
+        // Find the ends of non-descending runs, give up if there are too many
+        const_iterator run_ends[max_natural_runs];
+        size_type runs = 0;
+        bool nearly_sorted = true;
+        auto it = cbegin();
+        for (auto next = std::next(it); next != cend(); it = next++) {
+            if (!c(*next, *it))
+                continue;
+            if (runs + 1 == max_natural_runs) {
+                nearly_sorted = false;
+                break;
+            }
+            run_ends[runs++] = it;
+        }
+
+        if (!nearly_sorted) {
+            // It is compliant to standard since O(N log N) + O(N) => O(N log N)
+            // But I agree it is not the greatest implementation
+            m_list.sort(c);
+            adjust_last_iterator_on_reorder();
+        }
+        else if (runs == 0) {
+            m_last = it;
+        }
+        else {
+            run_ends[runs++] = it;
+            natural_merge_sort(run_ends, runs, c);
+        }
+    }
+
+    // New!
+    void sort(forward_list2_array_sort_t tag) { sort(tag, std::less<T>()); }
+
+    template<typename Compare>
+    void sort(forward_list2_array_sort_t tag, Compare c)
+    {
+        sort_buffer buffer(get_allocator());
+        sort(tag, c, buffer);
+    }
+
+    template<typename Compare>
+    void sort(forward_list2_array_sort_t, Compare c, sort_buffer& buffer)
+    {
+        // Pointers are sorted instead of the lists so no node is held
+        // by a temporary if the comparison throws
+        auto& nodes = buffer.m_nodes;
+        auto& order = buffer.m_order;
+        split_nodes(nodes);
+        try {
+            order.reserve(nodes.size());
+            for (auto& node : nodes)
+                order.push_back(&node);
+            std::sort(order.begin(), order.end(),
+                [&c](const Base* lhs, const Base* rhs) { return c(lhs->front(), rhs->front()); });
+        }
+        catch (...) {
+            order.clear();
+            link_nodes(nodes);
+            throw;
+        }
+
+        for (auto node : order)
+            append_node(*node);
+        order.clear();
+        nodes.clear();
+    }
+
+    // New!
+    template<typename KeyFunction>
+    void sort_by_key(KeyFunction key)
+    {
+        using Key = typename std::decay<decltype(key(std::declval<const T&>()))>::type;
+        sort_by_key(key, std::less<Key>());
+    }
+
+    template<typename KeyFunction, typename Compare>
+    void sort_by_key(KeyFunction key, Compare c)
+    {
+        using Key = typename std::decay<decltype(key(std::declval<const T&>()))>::type;
+        using KeyIndex = std::pair<Key, size_type>;
+
+        const auto count = static_cast<size_type>(std::distance(cbegin(), cend()));
+        if (count < 2)
+            return;
+
+        // Each key is computed once, the list is intact until the keys are sorted.
+        // The arrays are allocated once each, stable_sort may take a temporary buffer.
+        std::vector<KeyIndex, rebind_allocator<KeyIndex>> keys(get_allocator());
+        keys.reserve(count);
+        for (const auto& value : *this)
+            keys.emplace_back(key(value), keys.size());
+
+        std::stable_sort(keys.begin(), keys.end(),
+            [&c](const KeyIndex& lhs, const KeyIndex& rhs) { return c(lhs.first, rhs.first); });
+
+        std::vector<Base, rebind_allocator<Base>> nodes(get_allocator());
+        nodes.reserve(count);
+        split_nodes(nodes);
+        for (const auto& k : keys)
+            append_node(nodes[k.second]);
+    }
+
+    // New!
+    void radix_sort() { radix_sort(radix_identity()); }
+
+    template<typename KeyFunction>
+    void radix_sort(KeyFunction key)
+    {
+        using Key = typename std::decay<decltype(key(std::declval<const T&>()))>::type;
+        static_assert(std::is_integral<Key>::value && !std::is_same<Key, bool>::value, "radix_sort requires integral keys");
+        using UKey = typename std::make_unsigned<Key>::type;
+
+        if (empty() || std::next(cbegin()) == cend())
+            return;
+
+        // Signed keys are ordered as unsigned ones with the sign bit flipped
+        const int bits = std::numeric_limits<UKey>::digits;
+        const UKey sign = std::is_signed<Key>::value ? UKey(UKey(1) << (bits - 1)) : UKey(0);
+
+        // Skip passes over bytes which are the same for all the keys
+        const UKey first_key = static_cast<UKey>(key(front()));
+        UKey diff = 0;
+        for (const auto& value : *this)
+            diff |= static_cast<UKey>(key(value)) ^ first_key;
+
+        std::vector<forward_list2> buckets;
+        buckets.reserve(256);
+        for (int i = 0; i < 256; ++i)
+            buckets.emplace_back(get_allocator());
+
+        for (int shift = 0; shift < bits; shift += 8) {
+            if (((diff >> shift) & 0xFF) == 0)
+                continue;
+
+            try {
+                while (!empty()) {
+                    auto& bucket = buckets[((static_cast<UKey>(key(front())) ^ sign) >> shift) & 0xFF];
+                    bucket.splice_after(bucket.before_end(), *this, before_begin());
+                }
+            }
+            catch (...) {
+                // Keep all the elements, in unspecified order
+                for (auto& bucket : buckets)
+                    splice_after(before_end(), bucket);
+                throw;
+            }
+
+            for (auto& bucket : buckets)
+                splice_after(before_end(), bucket);
+        }
     }
 
     friend bool operator==(const forward_list2& lhs, const forward_list2& rhs)
@@ -405,6 +831,165 @@ public:
 #endif
 
 private:
+    static const size_type max_natural_runs = 32;
+
+    // Scratch arrays are allocated with the list allocator
+    template<typename U>
+    using rebind_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
+    class run_lists;
+
+    // Merges the runs pairwise, the tail is maintained by merge
+    template<typename Compare>
+    void natural_merge_sort(const const_iterator* run_ends, size_type runs, Compare& c)
+    {
+        run_lists lists;
+        for (size_type i = 0; i < runs; ++i)
+            lists.push_back(detach_front_until(run_ends[i]));
+
+        try {
+            for (size_type width = 1; width < runs; width *= 2)
+                for (size_type i = 0; i + width < runs; i += 2 * width)
+                    lists[i].merge(lists[i + width], c);
+        }
+        catch (...) {
+            // Keep all the elements, as std::forward_list::sort does
+            for (size_type i = 0; i < runs; ++i)
+                m_list.splice_after(m_list.cbefore_begin(), lists[i].m_list);
+            adjust_last_iterator_on_reorder();
+            throw;
+        }
+
+        swap(lists[0]);
+    }
+
+    // Detaches every node to a separate list appended to the buffer
+    template<typename NodeVector>
+    void split_nodes(NodeVector& nodes)
+    {
+        try {
+            while (!m_list.empty()) {
+                nodes.emplace_back(get_allocator());
+                nodes.back().splice_after(nodes.back().cbefore_begin(), m_list, m_list.cbefore_begin());
+            }
+        }
+        catch (...) {
+            // The tail has not been detached yet
+            for (auto it = nodes.rbegin(); it != nodes.rend(); ++it)
+                m_list.splice_after(m_list.cbefore_begin(), *it, it->cbefore_begin());
+            nodes.clear();
+            throw;
+        }
+        adjust_last_iterator_on_clear();
+    }
+
+    // Relinks the detached nodes in the buffer order, which yields the tail
+    template<typename NodeVector>
+    void link_nodes(NodeVector& nodes) noexcept
+    {
+        for (auto& node : nodes)
+            append_node(node);
+        nodes.clear();
+    }
+
+    void append_node(Base& node) noexcept
+    {
+        m_list.splice_after(m_last, node, node.cbefore_begin());
+        ++m_last;
+    }
+
+    // Open addressing set of pointers to the elements, grows at half load
+    template<typename Hash, typename KeyEqual>
+    class element_set
+    {
+    public:
+        element_set(Hash& hash, KeyEqual& eq) :
+            m_table(16), m_shift(std::numeric_limits<std::size_t>::digits - 4), m_size(0), m_hash(hash), m_eq(eq)
+        { }
+
+        bool insert(const T& value)
+        {
+            if (2 * (m_size + 1) > m_table.size())
+                grow();
+
+            auto i = slot(value);
+            for (; m_table[i] != nullptr; i = (i + 1) & (m_table.size() - 1))
+                if (m_eq(*m_table[i], value))
+                    return false;
+
+            m_table[i] = &value;
+            ++m_size;
+            return true;
+        }
+
+    private:
+        // Fibonacci hashing spreads identity hashes of integers over the table
+        std::size_t slot(const T& value) const
+        {
+            return (static_cast<std::size_t>(m_hash(value)) * static_cast<std::size_t>(0x9E3779B97F4A7C15ULL)) >> m_shift;
+        }
+
+        void grow()
+        {
+            std::vector<const T*> old(m_table.size() * 2);
+            old.swap(m_table);
+            --m_shift;
+            for (auto value : old) {
+                if (value == nullptr)
+                    continue;
+                auto i = slot(*value);
+                while (m_table[i] != nullptr)
+                    i = (i + 1) & (m_table.size() - 1);
+                m_table[i] = value;
+            }
+        }
+
+        std::vector<const T*> m_table;
+        int                   m_shift;
+        size_type             m_size;
+        Hash&                 m_hash;
+        KeyEqual&             m_eq;
+    };
+
+    struct radix_identity
+    {
+        const T& operator()(const T& value) const noexcept { return value; }
+    };
+
+    void transfer_front(forward_list2& to)
+    {
+        to.splice_after(to.before_end(), *this, before_begin());
+    }
+
+    forward_list2 detach_front_until(const_iterator last)
+    {
+        forward_list2 result(get_allocator());
+        if (std::next(last) == cend()) {
+            swap(result);
+        }
+        else if (last != cbefore_begin()) {
+            // Nodes are relinked without touching the elements
+            result.m_list.splice_after(result.cbefore_begin(), m_list, cbefore_begin(), std::next(last));
+            result.m_last = last;
+        }
+        return result;
+    }
+
+    // Erases all elements after the first count ones, returns the number of missing elements
+    size_type truncate(size_type count)
+    {
+        auto it = before_begin();
+        for (size_type i = 0; i < count; ++i, ++it) {
+            if (std::next(it) == end()) {
+                m_last = it;
+                return count - i;
+            }
+        }
+
+        erase_after(it, end());
+        return 0;
+    }
+
     void insert_to_empty(size_type count, const T& value)
     {
         m_last = m_list.insert_after(m_list.before_begin(), count, value);
@@ -426,6 +1011,15 @@ private:
         m_last = m_list.before_begin();
     }
 
+    void adjust_last_iterator_on_move(const const_iterator& other_last) noexcept
+    {
+        // Iterator to the head of empty list points to the list object itself
+        if (empty())
+            adjust_last_iterator_on_clear();
+        else
+            m_last = other_last;
+    }
+
     void adjust_last_iterator_on_insertion(const const_iterator& first, const const_iterator& last) noexcept
     {
         if (first == m_last)
@@ -440,19 +1034,103 @@ private:
 
     void adjust_last_iterator_on_merge(const const_iterator& other_last) noexcept
     {
-        if (std::next(m_last) != cend())
+        // Unknown tail of any list makes the merged tail unknown too
+        if (m_last == cend() || other_last == cend())
+            m_last = cend();
+        else if (std::next(m_last) != cend())
             m_last = other_last;
     }
 
-    void adjust_last_iterator_linear_time() noexcept
+    void adjust_last_iterator_on_reorder() noexcept
+    {
+#if FORWARD_LIST2_LAZY_LAST
+        m_last = cend();
+#else
+        adjust_last_iterator_linear_time();
+#endif
+    }
+
+    // Not thread-safe in lazy mode: the tail is updated by const accessors
+    const_iterator resolve_last_iterator() const noexcept
+    {
+        if (m_last == cend())
+            adjust_last_iterator_linear_time();
+        return m_last;
+    }
+
+    void adjust_last_iterator_linear_time() const noexcept
     {
         m_last = m_list.before_begin();
-        while (std::next(m_last) != cend())
+        while (std::next(m_last) != cend()) {
+            FORWARD_LIST2_ON_TAIL_WALK_STEP();
             ++m_last;
+        }
+    }
+
+    Base                   m_list;
+
+    // end() if the tail is not known yet
+    mutable const_iterator m_last;
+};
+
+// Lists of the natural runs of sort, constructed in place so that
+// sort neither allocates nor requires a default constructible allocator
+template<typename T, class Allocator>
+class forward_list2<T, Allocator>::run_lists
+{
+public:
+    run_lists() = default;
+    run_lists(const run_lists&) = delete;
+    run_lists& operator=(const run_lists&) = delete;
+
+    ~run_lists()
+    {
+        for (size_type i = 0; i < m_size; ++i)
+            (*this)[i].~forward_list2();
+    }
+
+    void push_back(forward_list2&& list)
+    {
+        ::new (static_cast<void*>(m_slots[m_size].bytes)) forward_list2(std::move(list));
+        ++m_size;
     }
 
-    Base           m_list;
-    const_iterator m_last;
+    forward_list2& operator[](size_type i) noexcept { return *reinterpret_cast<forward_list2*>(m_slots[i].bytes); }
+
+private:
+    struct slot
+    {
+        alignas(forward_list2) unsigned char bytes[sizeof(forward_list2)];
+    };
+
+    slot      m_slots[max_natural_runs];
+    size_type m_size = 0;
+};
+
+// Scratch space of the array sort, may be reused by the lists of the same type.
+// It is allocated with the list allocator; once reserved, sorting up to
+// capacity() elements allocates nothing.
+template<typename T, class Allocator>
+class forward_list2<T, Allocator>::sort_buffer
+{
+public:
+    explicit sort_buffer(const Allocator& alloc = Allocator()) :
+        m_nodes(alloc), m_order(alloc)
+    { }
+
+    void reserve(size_type n)
+    {
+        m_nodes.reserve(n);
+        m_order.reserve(n);
+    }
+
+    size_type capacity() const noexcept { return std::min(m_nodes.capacity(), m_order.capacity()); }
+
+private:
+    friend class forward_list2;
+
+    std::vector<Base, rebind_allocator<Base>>   m_nodes;
+    std::vector<Base*, rebind_allocator<Base*>> m_order;
 };
 
 namespace std
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+
+#ifndef FORWARD_LIST_2_ARENA_HPP
+#define FORWARD_LIST_2_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+struct forward_list2_arena_options
+{
+    // Size of the memory chunks, rounded up to 2 MiB for huge pages
+    // and to 4 KiB otherwise
+    std::size_t chunk_size = std::size_t(16) << 20;
+
+    // Try MAP_HUGETLB first, then transparent huge pages
+    bool huge_pages = true;
+
+    // NUMA node to bind the chunks to, negative for the default policy
+    int numa_node = -1;
+};
+
+// Arena for list nodes. Chunks are mapped with huge pages where available
+// to reduce TLB misses on traversal, falling back to regular pages and
+// then to operator new. Freed blocks are kept in per-size free lists and
+// the memory is returned to the system only when the arena is destroyed.
+// The arena is not thread-safe.
+class forward_list2_arena
+{
+public:
+    enum class backing { hugetlb, transparent_huge_pages, pages, heap };
+
+    explicit forward_list2_arena(const forward_list2_arena_options& options = forward_list2_arena_options()) :
+        m_options(options), m_hugetlb_failed(false), m_current(nullptr), m_left(0)
+    {
+        // A chunk must hold the largest small block, see add_chunk
+        const std::size_t unit = m_options.huge_pages ? huge_page_size : page_size;
+        m_options.chunk_size = (std::max(m_options.chunk_size, unit) + unit - 1) / unit * unit;
+    }
+
+    forward_list2_arena(const forward_list2_arena&) = delete;
+    forward_list2_arena& operator=(const forward_list2_arena&) = delete;
+
+    ~forward_list2_arena()
+    {
+        for (const auto& c : m_chunks)
+            release(c);
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment)
+    {
+        if (bytes > max_small_size || alignment > granule)
+            return allocate_large(bytes, alignment);
+
+        auto& free_list = m_free[size_class(bytes)];
+        if (free_list != nullptr) {
+            auto block = free_list;
+            free_list = block->next;
+            return block;
+        }
+
+        const auto size = (size_class(bytes) + 1) * granule;
+        if (m_left < size)
+            add_chunk();
+
+        auto result = m_current;
+        m_current += size;
+        m_left -= size;
+        return result;
+    }
+
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept
+    {
+        if (bytes > max_small_size || alignment > granule) {
+            deallocate_large(p, alignment);
+            return;
+        }
+
+        auto block = static_cast<free_block*>(p);
+        auto& free_list = m_free[size_class(bytes)];
+        block->next = free_list;
+        free_list = block;
+    }
+
+    std::size_t chunks() const noexcept { return m_chunks.size(); }
+
+    std::size_t chunks(backing b) const noexcept
+    {
+        std::size_t result = 0;
+        for (const auto& c : m_chunks)
+            if (c.kind == b)
+                ++result;
+        return result;
+    }
+
+    // False if binding to the NUMA node has failed for any chunk
+    bool numa_bound() const noexcept
+    {
+        for (const auto& c : m_chunks)
+            if (!c.numa_bound)
+                return false;
+        return true;
+    }
+
+private:
+    static const std::size_t granule = 16;
+    static const std::size_t max_small_size = 512;
+    static const std::size_t page_size      = std::size_t(4) << 10;
+    static const std::size_t huge_page_size = std::size_t(2) << 20;
+
+    struct free_block { free_block* next; };
+
+    struct chunk
+    {
+        char*       memory;
+        std::size_t size;
+        backing     kind;
+        bool        numa_bound;
+    };
+
+    static std::size_t size_class(std::size_t bytes) noexcept
+    {
+        return bytes == 0 ? 0 : (bytes - 1) / granule;
+    }
+
+    static void* allocate_large(std::size_t bytes, std::size_t alignment)
+    {
+#ifdef __cpp_aligned_new
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(bytes, std::align_val_t(alignment));
+#endif
+        (void)alignment;
+        return ::operator new(bytes);
+    }
+
+    static void deallocate_large(void* p, std::size_t alignment) noexcept
+    {
+#ifdef __cpp_aligned_new
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(p, std::align_val_t(alignment));
+            return;
+        }
+#endif
+        (void)alignment;
+        ::operator delete(p);
+    }
+
+    void add_chunk()
+    {
+        m_chunks.reserve(m_chunks.size() + 1);
+        auto c = acquire(m_options.chunk_size);
+        m_chunks.push_back(c);
+
+        // The rest of the previous chunk is not worth tracking
+        m_current = c.memory;
+        m_left = c.size;
+    }
+
+    chunk acquire(std::size_t size)
+    {
+        chunk c{ nullptr, size, backing::heap, m_options.numa_node < 0 };
+#ifdef __linux__
+        void* p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+        if (m_options.huge_pages && !m_hugetlb_failed) {
+            p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            c.kind = backing::hugetlb;
+            // The pool of huge pages is not going to grow while we run
+            m_hugetlb_failed = p == MAP_FAILED;
+        }
+#endif
+        if (p == MAP_FAILED) {
+            p = map_aligned(size, m_options.huge_pages ? huge_page_size : 0);
+            c.kind = backing::pages;
+#ifdef MADV_HUGEPAGE
+            if (p != MAP_FAILED && m_options.huge_pages && ::madvise(p, size, MADV_HUGEPAGE) == 0)
+                c.kind = backing::transparent_huge_pages;
+#endif
+        }
+        if (p != MAP_FAILED) {
+            c.memory = static_cast<char*>(p);
+            if (m_options.numa_node >= 0)
+                c.numa_bound = bind(p, size, m_options.numa_node);
+            return c;
+        }
+#endif
+        c.memory = static_cast<char*>(::operator new(size));
+        c.kind = backing::heap;
+        return c;
+    }
+
+#ifdef __linux__
+    // Transparent huge pages are used only for aligned ranges, so the mapping
+    // is made larger and trimmed to the alignment
+    static void* map_aligned(std::size_t size, std::size_t alignment) noexcept
+    {
+        auto p = ::mmap(nullptr, size + alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED || alignment == 0)
+            return p;
+
+        auto begin = reinterpret_cast<std::uintptr_t>(p);
+        auto aligned = (begin + alignment - 1) / alignment * alignment;
+        if (aligned > begin)
+            ::munmap(p, aligned - begin);
+        if (begin + alignment > aligned)
+            ::munmap(reinterpret_cast<void*>(aligned + size), begin + alignment - aligned);
+        return reinterpret_cast<void*>(aligned);
+    }
+#endif
+
+    // mbind(2) with MPOL_BIND, before any page of the chunk is touched
+    static bool bind(void* p, std::size_t size, int node) noexcept
+    {
+#if defined(__linux__) && defined(SYS_mbind)
+        const int mpol_bind = 2;
+        const std::size_t bits = 8 * sizeof(unsigned long);
+        std::vector<unsigned long> mask(node / bits + 1);
+        mask[node / bits] = 1UL << (node % bits);
+        return ::syscall(SYS_mbind, p, size, mpol_bind, mask.data(), mask.size() * bits + 1, 0) == 0;
+#else
+        (void)p; (void)size; (void)node;
+        return false;
+#endif
+    }
+
+    static void release(const chunk& c) noexcept
+    {
+#ifdef __linux__
+        if (c.kind != backing::heap) {
+            ::munmap(c.memory, c.size);
+            return;
+        }
+#endif
+        ::operator delete(c.memory);
+    }
+
+    forward_list2_arena_options m_options;
+    bool                        m_hugetlb_failed;
+    std::vector<chunk>          m_chunks;
+    char*                       m_current;
+    std::size_t                 m_left;
+    free_block*                 m_free[max_small_size / granule] = { };
+};
+
+// Allocator which takes the nodes from a forward_list2_arena,
+// the arena follows the nodes on move assignment and swap
+template<typename T>
+class forward_list2_arena_allocator
+{
+public:
+    using value_type = T;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    explicit forward_list2_arena_allocator(forward_list2_arena& arena) noexcept : m_arena(&arena) { }
+
+    template<typename U>
+    forward_list2_arena_allocator(const forward_list2_arena_allocator<U>& other) noexcept : m_arena(&other.arena()) { }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        m_arena->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    forward_list2_arena& arena() const noexcept { return *m_arena; }
+
+    template<typename U>
+    bool operator==(const forward_list2_arena_allocator<U>& rhs) const noexcept { return m_arena == &rhs.arena(); }
+
+    template<typename U>
+    bool operator!=(const forward_list2_arena_allocator<U>& rhs) const noexcept { return m_arena != &rhs.arena(); }
+
+private:
+    forward_list2_arena* m_arena;
+};
+
+#endif // FORWARD_LIST_2_ARENA_HPP
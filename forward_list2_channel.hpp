@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FORWARD_LIST_2_CHANNEL_HPP
+#define FORWARD_LIST_2_CHANNEL_HPP
+
+#include "forward_list2.hpp"
+
+#ifdef __cpp_impl_coroutine
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+// Single-threaded executor which resumes scheduled coroutines in FIFO order
+class forward_list2_executor
+{
+public:
+    class task;
+
+    forward_list2_executor() = default;
+    forward_list2_executor(const forward_list2_executor&) = delete;
+    forward_list2_executor& operator=(const forward_list2_executor&) = delete;
+
+    ~forward_list2_executor()
+    {
+        for (auto handle : m_ready)
+            handle.destroy();
+    }
+
+    void schedule(std::coroutine_handle<> handle) { m_ready.push_back(handle); }
+
+    void spawn(task&& t);
+
+    bool run_one()
+    {
+        if (m_ready.empty())
+            return false;
+
+        auto handle = m_ready.front();
+        m_ready.pop_front();
+        handle.resume();
+        return true;
+    }
+
+    void run()
+    {
+        while (run_one()) { }
+    }
+
+    // Reschedules the calling coroutine after the ones which are ready
+    auto yield() noexcept
+    {
+        struct awaiter
+        {
+            forward_list2_executor& executor;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { executor.schedule(handle); }
+            void await_resume() const noexcept { }
+        };
+        return awaiter{ *this };
+    }
+
+private:
+    forward_list2<std::coroutine_handle<>> m_ready;
+};
+
+// Fire-and-forget coroutine, starts when it is spawned on the executor
+class forward_list2_executor::task
+{
+public:
+    struct promise_type
+    {
+        task get_return_object() { return task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept { }
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    task(task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) { }
+    task& operator=(task&&) = delete;
+
+    ~task()
+    {
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+private:
+    friend class forward_list2_executor;
+
+    explicit task(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) { }
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+inline void forward_list2_executor::spawn(task&& t)
+{
+    schedule(std::exchange(t.m_handle, nullptr));
+}
+
+// Queue which resumes waiting consumers on push instead of being polled
+template<typename T, class Allocator = std::allocator<T>>
+class forward_list2_channel
+{
+public:
+    using list_type = forward_list2<T, Allocator>;
+    using size_type = typename list_type::size_type;
+
+    explicit forward_list2_channel(forward_list2_executor& executor, const Allocator& alloc = Allocator()) :
+        m_executor(executor), m_items(alloc)
+    { }
+
+    forward_list2_channel(const forward_list2_channel&) = delete;
+    forward_list2_channel& operator=(const forward_list2_channel&) = delete;
+
+    // Coroutines still waiting for elements are destroyed with the channel
+    ~forward_list2_channel()
+    {
+        while (!m_waiters.empty()) {
+            auto handle = m_waiters.front()->m_handle;
+            m_waiters.pop_front();
+            handle.destroy();
+        }
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return m_items.empty(); }
+
+    void push_back(const T& value)
+    {
+        m_items.push_back(value);
+        wake();
+    }
+
+    void push_back(T&& value)
+    {
+        m_items.push_back(std::move(value));
+        wake();
+    }
+
+    template<class... Args>
+    void emplace_back(Args&&... args)
+    {
+        m_items.emplace_back(std::forward<Args>(args)...);
+        wake();
+    }
+
+    class batch_awaiter
+    {
+    public:
+        bool await_ready()
+        {
+            if (m_count > 0 && (m_channel.m_items.empty() || !m_channel.m_waiters.empty()))
+                return false;
+
+            m_batch = m_channel.m_items.detach_front(m_count);
+            return true;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            m_handle = handle;
+            m_channel.m_waiters.push_back(this);
+        }
+
+        list_type await_resume() noexcept { return std::move(m_batch); }
+
+    protected:
+        friend class forward_list2_channel;
+
+        batch_awaiter(forward_list2_channel& channel, size_type count) :
+            m_channel(channel), m_count(count), m_batch(channel.m_items.get_allocator())
+        { }
+
+        forward_list2_channel&  m_channel;
+        size_type               m_count;
+        list_type               m_batch;
+        std::coroutine_handle<> m_handle;
+    };
+
+    class value_awaiter : public batch_awaiter
+    {
+    public:
+        T await_resume() { return std::move(this->m_batch.front()); }
+
+    private:
+        friend class forward_list2_channel;
+
+        explicit value_awaiter(forward_list2_channel& channel) : batch_awaiter(channel, 1) { }
+    };
+
+    // Waits for an element and pops it
+    value_awaiter pop() { return value_awaiter(*this); }
+
+    // Waits for at least one element and pops up to count elements as a list
+    batch_awaiter pop_batch(size_type count) { return batch_awaiter(*this, count); }
+
+private:
+    void wake()
+    {
+        while (!m_waiters.empty() && !m_items.empty()) {
+            auto waiter = m_waiters.front();
+            m_waiters.pop_front();
+            waiter->m_batch = m_items.detach_front(waiter->m_count);
+            m_executor.schedule(waiter->m_handle);
+        }
+    }
+
+    forward_list2_executor&        m_executor;
+    list_type                      m_items;
+    forward_list2<batch_awaiter*>  m_waiters;
+};
+
+#endif // __cpp_impl_coroutine
+
+#endif // FORWARD_LIST_2_CHANNEL_HPP
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FORWARD_LIST_2_COLLECTOR_HPP
+#define FORWARD_LIST_2_COLLECTOR_HPP
+
+#include "forward_list2.hpp"
+
+#include <vector>
+
+// Set of forward_list2 shards, one per worker, which are concatenated
+// into a single list after the workers are done. Each shard may be used
+// by only one thread at a time; different shards need no synchronization.
+template<typename T, class Allocator = std::allocator<T>>
+class forward_list2_collector
+{
+public:
+    using list_type = forward_list2<T, Allocator>;
+    using size_type = typename list_type::size_type;
+    using reference = typename list_type::reference;
+
+    explicit forward_list2_collector(size_type shards, const Allocator& alloc = Allocator()) :
+        m_alloc(alloc)
+    {
+        m_shards.reserve(shards);
+        for (size_type i = 0; i < shards; ++i)
+            m_shards.emplace_back(alloc);
+    }
+
+    size_type shards() const noexcept { return m_shards.size(); }
+
+    template<class... Args>
+    reference emplace_back(size_type shard, Args&&... args)
+    {
+        auto& s = m_shards[shard];
+        auto& result = s.list.emplace_back(std::forward<Args>(args)...);
+        ++s.size;
+        return result;
+    }
+
+    void push_back(size_type shard, const T& value) { emplace_back(shard, value); }
+    void push_back(size_type shard, T&& value)      { emplace_back(shard, std::move(value)); }
+
+    // Concatenates the shards in shard order and empties them
+    list_type collect()
+    {
+        list_type result(m_alloc);
+        for (auto& s : m_shards)
+            append(result, s);
+
+        return result;
+    }
+
+    // Concatenates the shards starting from the largest one, which is not walked
+    list_type collect_unordered()
+    {
+        list_type result(m_alloc);
+        if (m_shards.empty())
+            return result;
+
+        auto largest = m_shards.begin();
+        for (auto it = m_shards.begin(); it != m_shards.end(); ++it)
+            if (it->size > largest->size)
+                largest = it;
+
+        append(result, *largest);
+        for (auto& s : m_shards)
+            append(result, s);
+
+        return result;
+    }
+
+private:
+    struct shard
+    {
+        explicit shard(const Allocator& alloc) : list(alloc), size(0) { }
+
+        list_type list;
+        size_type size;
+
+        // Keeps shards of different workers in different cache lines
+        char padding[64];
+    };
+
+    // The first shard is taken over without walking it
+    static void append(list_type& result, shard& s)
+    {
+        result.splice_after(result.before_end(), s.list);
+        s.size = 0;
+    }
+
+    Allocator          m_alloc;
+    std::vector<shard> m_shards;
+};
+
+#endif // FORWARD_LIST_2_COLLECTOR_HPP
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FORWARD_LIST_2_COW_HPP
+#define FORWARD_LIST_2_COW_HPP
+
+#include "forward_list2.hpp"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+// Copy-on-write forward_list2: copies share the nodes until one of them
+// is modified. The reference counter is atomic, so copies may be handed
+// to other threads, but a single object must not be modified concurrently.
+//
+// Modification of a shared list copies it, so iterators obtained
+// before the modification must not be passed to mutate().insert_after
+// and friends. Obtain them from mutate() instead.
+template<typename T, class Allocator = std::allocator<T>>
+class cow_forward_list2
+{
+public:
+    using list_type       = forward_list2<T, Allocator>;
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using size_type       = typename list_type::size_type;
+    using const_reference = typename list_type::const_reference;
+    using const_iterator  = typename list_type::const_iterator;
+
+    cow_forward_list2() :
+        m_shared(new shared_list())
+    { }
+
+    explicit cow_forward_list2(const Allocator& alloc) :
+        m_shared(new shared_list(alloc))
+    { }
+
+    explicit cow_forward_list2(list_type list) :
+        m_shared(new shared_list(std::move(list)))
+    { }
+
+    cow_forward_list2(std::initializer_list<T> init, const Allocator& alloc = Allocator()) :
+        m_shared(new shared_list(init, alloc))
+    { }
+
+    template<class InputIt>
+    cow_forward_list2(InputIt first, InputIt last, const Allocator& alloc = Allocator()) :
+        m_shared(new shared_list(first, last, alloc))
+    { }
+
+    // Copies are O(1), there are no move operations so the source stays valid
+    cow_forward_list2(const cow_forward_list2& other) noexcept :
+        m_shared(other.m_shared)
+    {
+        share();
+    }
+
+    cow_forward_list2& operator=(const cow_forward_list2& other) noexcept
+    {
+        other.share();
+        release();
+        m_shared = other.m_shared;
+        return *this;
+    }
+
+    ~cow_forward_list2() { release(); }
+
+    const list_type& get() const noexcept { return m_shared->list; }
+
+    list_type& mutate()
+    {
+        if (shared()) {
+            auto copy = new shared_list(m_shared->list);
+            release();
+            m_shared = copy;
+        }
+        return m_shared->list;
+    }
+
+    // Acquire pairs with the release of the other copies, so once they are
+    // gone, their reads of the list happen before our modifications
+    bool shared() const noexcept { return m_shared->refs.load(std::memory_order_acquire) > 1; }
+
+    allocator_type get_allocator() const noexcept { return get().get_allocator(); }
+
+    [[nodiscard]] bool empty() const noexcept { return get().empty(); }
+
+    const_reference front() const { return get().front(); }
+    const_reference back()  const { return get().back(); }
+
+    const_iterator before_begin()  const noexcept { return get().before_begin(); }
+    const_iterator cbefore_begin() const noexcept { return get().cbefore_begin(); }
+    const_iterator begin()         const noexcept { return get().begin(); }
+    const_iterator cbegin()        const noexcept { return get().cbegin(); }
+    const_iterator before_end()    const noexcept { return get().before_end(); }
+    const_iterator cbefore_end()   const noexcept { return get().cbefore_end(); }
+    const_iterator end()           const noexcept { return get().end(); }
+    const_iterator cend()          const noexcept { return get().cend(); }
+
+    void push_front(const T& value) { mutate().push_front(value); }
+    void push_front(T&& value)      { mutate().push_front(std::move(value)); }
+    void push_back(const T& value)  { mutate().push_back(value); }
+    void push_back(T&& value)       { mutate().push_back(std::move(value)); }
+
+    template<class... Args>
+    void emplace_front(Args&&... args) { mutate().emplace_front(std::forward<Args>(args)...); }
+
+    template<class... Args>
+    void emplace_back(Args&&... args) { mutate().emplace_back(std::forward<Args>(args)...); }
+
+    void pop_front() { mutate().pop_front(); }
+
+    // Releases the shared nodes without copying them
+    void clear()
+    {
+        if (shared()) {
+            auto empty = new shared_list(get_allocator());
+            release();
+            m_shared = empty;
+        }
+        else
+            m_shared->list.clear();
+    }
+
+    void swap(cow_forward_list2& other) noexcept { std::swap(m_shared, other.m_shared); }
+
+    friend bool operator==(const cow_forward_list2& lhs, const cow_forward_list2& rhs)
+    {
+        return lhs.m_shared == rhs.m_shared || lhs.get() == rhs.get();
+    }
+
+    friend bool operator!=(const cow_forward_list2& lhs, const cow_forward_list2& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    struct shared_list
+    {
+        template<class... Args>
+        explicit shared_list(Args&&... args) :
+            refs(1), list(std::forward<Args>(args)...)
+        {
+            list.before_end();
+        }
+
+        std::atomic<long> refs;
+        list_type         list;
+    };
+
+    // With FORWARD_LIST2_LAZY_LAST, before_end() of a const list may write
+    // the tail, so it is found while the list is not shared yet
+    void share() const noexcept
+    {
+        m_shared->list.before_end();
+        m_shared->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release() noexcept
+    {
+        if (m_shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete m_shared;
+    }
+
+    shared_list* m_shared;
+};
+
+namespace std
+{
+    template<typename T, typename Alloc>
+    void swap(cow_forward_list2<T, Alloc>& lhs, cow_forward_list2<T, Alloc>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif // FORWARD_LIST_2_COW_HPP
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FORWARD_LIST_2_PARALLEL_HPP
+#define FORWARD_LIST_2_PARALLEL_HPP
+
+#include "forward_list2.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// Splits [first, last) into at most 2 * count segments of equal length,
+// except for the last one, in a single pass. Whenever there are too many
+// segments, every other boundary is dropped and the segment length doubles.
+template<typename ForwardIt>
+std::vector<ForwardIt> forward_list2_segments(ForwardIt first, ForwardIt last, std::size_t count)
+{
+    std::vector<ForwardIt> bounds(1, first);
+    std::size_t step = 1;
+    std::size_t pending = 0;
+    for (; first != last; ++first, ++pending) {
+        if (pending < step)
+            continue;
+
+        bounds.push_back(first);
+        pending = 0;
+        if (bounds.size() > 2 * count) {
+            for (std::size_t i = 1; 2 * i < bounds.size(); ++i)
+                bounds[i] = bounds[2 * i];
+            bounds.resize((bounds.size() + 1) / 2);
+            step *= 2;
+        }
+    }
+
+    bounds.push_back(last);
+    return bounds;
+}
+
+// Calls f(segment_first, segment_last, worker) for contiguous parts of [first, last),
+// using the calling thread as worker 0. The first exception thrown by f is rethrown.
+template<typename ForwardIt, typename SegmentFunction>
+void forward_list2_parallel_segments(ForwardIt first, ForwardIt last, std::size_t threads, SegmentFunction f)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Segment lengths are powers of two, so a worker may get up to twice its
+    // share of a coarse split. With at least 8 equal segments per worker,
+    // the largest part exceeds the average by about 1/8 at most.
+    const std::size_t segments_per_worker = 8;
+    const auto bounds = forward_list2_segments(first, last, segments_per_worker * threads);
+    const auto segments = bounds.size() - 1;
+    threads = std::min(threads, segments);
+
+    std::vector<std::exception_ptr> errors(threads);
+    auto run = [&](std::size_t worker) {
+        try {
+            f(bounds[worker * segments / threads], bounds[(worker + 1) * segments / threads], worker);
+        }
+        catch (...) {
+            errors[worker] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    try {
+        for (std::size_t worker = 1; worker < threads; ++worker)
+            workers.emplace_back(run, worker);
+    }
+    catch (...) {
+        for (auto& w : workers)
+            w.join();
+        throw;
+    }
+
+    run(0);
+    for (auto& w : workers)
+        w.join();
+
+    for (const auto& error : errors)
+        if (error)
+            std::rethrow_exception(error);
+}
+
+template<typename T, class Allocator, typename UnaryFunction>
+void parallel_for_each(forward_list2<T, Allocator>& list, UnaryFunction f, std::size_t threads = 0)
+{
+    using iterator = typename forward_list2<T, Allocator>::iterator;
+    forward_list2_parallel_segments(list.begin(), list.end(), threads,
+        [&f](iterator first, iterator last, std::size_t) { std::for_each(first, last, f); });
+}
+
+template<typename T, class Allocator, typename UnaryOperation>
+void parallel_transform_inplace(forward_list2<T, Allocator>& list, UnaryOperation op, std::size_t threads = 0)
+{
+    using iterator = typename forward_list2<T, Allocator>::iterator;
+    forward_list2_parallel_segments(list.begin(), list.end(), threads,
+        [&op](iterator first, iterator last, std::size_t) { std::transform(first, last, first, op); });
+}
+
+template<typename T, class Allocator, typename UnaryPredicate>
+typename forward_list2<T, Allocator>::difference_type
+parallel_count_if(const forward_list2<T, Allocator>& list, UnaryPredicate p, std::size_t threads = 0)
+{
+    using const_iterator = typename forward_list2<T, Allocator>::const_iterator;
+    using difference_type = typename forward_list2<T, Allocator>::difference_type;
+
+    // Each worker writes its own counter, padded to avoid false sharing
+    struct counter { difference_type value; char padding[64]; };
+    std::vector<counter> counts(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency()));
+    forward_list2_parallel_segments(list.begin(), list.end(), counts.size(),
+        [&p, &counts](const_iterator first, const_iterator last, std::size_t worker) {
+            counts[worker].value = std::count_if(first, last, p);
+        });
+
+    difference_type result = 0;
+    for (const auto& c : counts)
+        result += c.value;
+    return result;
+}
+
+#endif // FORWARD_LIST_2_PARALLEL_HPP
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef FORWARD_LIST_2_QUEUE_HPP
+#define FORWARD_LIST_2_QUEUE_HPP
+
+#include "forward_list2.hpp"
+
+#include <queue>
+
+// forward_list2 which counts its elements, so it meets the requirements
+// of the std::queue container. Only the operations which keep the counter
+// valid are exposed, the list itself is available through list().
+template<typename T, class Allocator = std::allocator<T>>
+class sized_forward_list2
+{
+public:
+    using list_type       = forward_list2<T, Allocator>;
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using size_type       = typename list_type::size_type;
+    using difference_type = typename list_type::difference_type;
+    using reference       = typename list_type::reference;
+    using const_reference = typename list_type::const_reference;
+    using iterator        = typename list_type::iterator;
+    using const_iterator  = typename list_type::const_iterator;
+
+    sized_forward_list2() : sized_forward_list2(Allocator()) { }
+
+    explicit sized_forward_list2(const Allocator& alloc) :
+        m_list(alloc), m_size(0)
+    { }
+
+    sized_forward_list2(const sized_forward_list2& other, const Allocator& alloc) :
+        m_list(other.m_list, alloc), m_size(other.m_size)
+    { }
+
+    sized_forward_list2(sized_forward_list2&& other, const Allocator& alloc) :
+        m_list(std::move(other.m_list), alloc), m_size(other.m_size)
+    {
+        other.m_list.clear();
+        other.m_size = 0;
+    }
+
+    sized_forward_list2(const sized_forward_list2&) = default;
+    sized_forward_list2& operator=(const sized_forward_list2&) = default;
+
+    sized_forward_list2(sized_forward_list2&& other) noexcept :
+        m_list(std::move(other.m_list)), m_size(other.m_size)
+    {
+        other.m_size = 0;
+    }
+
+    sized_forward_list2& operator=(sized_forward_list2&& other)
+    {
+        m_list = std::move(other.m_list);
+        m_size = other.m_size;
+        other.m_list.clear();
+        other.m_size = 0;
+        return *this;
+    }
+
+    ~sized_forward_list2() = default;
+
+    const list_type& list() const noexcept { return m_list; }
+
+    allocator_type get_allocator() const noexcept { return m_list.get_allocator(); }
+
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    size_type size() const noexcept { return m_size; }
+
+    reference front()             { return m_list.front(); }
+    const_reference front() const { return m_list.front(); }
+    reference back()              { return m_list.back(); }
+    const_reference back() const  { return m_list.back(); }
+
+    iterator begin()              noexcept { return m_list.begin(); }
+    const_iterator begin()  const noexcept { return m_list.begin(); }
+    const_iterator cbegin() const noexcept { return m_list.cbegin(); }
+    iterator end()                noexcept { return m_list.end(); }
+    const_iterator end()    const noexcept { return m_list.end(); }
+    const_iterator cend()   const noexcept { return m_list.cend(); }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value)      { emplace_back(std::move(value)); }
+
+    template<class... Args>
+    reference emplace_back(Args&&... args)
+    {
+        auto& result = m_list.emplace_back(std::forward<Args>(args)...);
+        ++m_size;
+        return result;
+    }
+
+    void pop_front()
+    {
+        m_list.pop_front();
+        --m_size;
+    }
+
+    void clear() noexcept
+    {
+        m_list.clear();
+        m_size = 0;
+    }
+
+    void swap(sized_forward_list2& other) noexcept(noexcept(std::declval<list_type&>().swap(std::declval<list_type&>())))
+    {
+        m_list.swap(other.m_list);
+        std::swap(m_size, other.m_size);
+    }
+
+    friend bool operator==(const sized_forward_list2& lhs, const sized_forward_list2& rhs)
+    {
+        return lhs.m_size == rhs.m_size && lhs.m_list == rhs.m_list;
+    }
+
+    friend bool operator!=(const sized_forward_list2& lhs, const sized_forward_list2& rhs) { return !(lhs == rhs); }
+    friend bool operator<(const sized_forward_list2& lhs, const sized_forward_list2& rhs)  { return lhs.m_list < rhs.m_list; }
+    friend bool operator>(const sized_forward_list2& lhs, const sized_forward_list2& rhs)  { return rhs < lhs; }
+    friend bool operator<=(const sized_forward_list2& lhs, const sized_forward_list2& rhs) { return !(rhs < lhs); }
+    friend bool operator>=(const sized_forward_list2& lhs, const sized_forward_list2& rhs) { return !(lhs < rhs); }
+
+private:
+    list_type m_list;
+    size_type m_size;
+};
+
+namespace std
+{
+    template<typename T, typename Alloc>
+    void swap(sized_forward_list2<T, Alloc>& lhs, sized_forward_list2<T, Alloc>& rhs)
+        noexcept(noexcept(lhs.swap(rhs)))
+    {
+        lhs.swap(rhs);
+    }
+}
+
+template<typename T, class Allocator = std::allocator<T>>
+using forward_list2_queue = std::queue<T, sized_forward_list2<T, Allocator>>;
+
+#endif // FORWARD_LIST_2_QUEUE_HPP
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+
+#ifndef FORWARD_LIST_2_RECLAIMER_HPP
+#define FORWARD_LIST_2_RECLAIMER_HPP
+
+#include "forward_list2.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Destroys retired lists out of the latency-critical path: on a background
+// thread, or on drain() in the deferred mode. The elements are destroyed and
+// the nodes are deallocated on that thread, so the allocator must allow it.
+template<typename T, class Allocator = std::allocator<T>>
+class forward_list2_reclaimer
+{
+public:
+    using list_type = forward_list2<T, Allocator>;
+
+    enum class mode { background, deferred };
+
+    explicit forward_list2_reclaimer(mode m = mode::background) :
+        m_stop(false)
+    {
+        if (m == mode::background)
+            m_thread = std::thread(&forward_list2_reclaimer::run, this);
+    }
+
+    forward_list2_reclaimer(const forward_list2_reclaimer&) = delete;
+    forward_list2_reclaimer& operator=(const forward_list2_reclaimer&) = delete;
+
+    // Lists retired before are destroyed before returning
+    ~forward_list2_reclaimer()
+    {
+        if (m_thread.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wakeup.notify_one();
+            m_thread.join();
+        }
+        drain();
+    }
+
+    // Takes over the nodes of the list in O(1), the list is left empty
+    void retire(list_type& list)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending.emplace_back(std::move(list));
+        }
+        list.clear();
+        m_wakeup.notify_one();
+    }
+
+    void retire(list_type&& list) { retire(list); }
+
+    // Destroys the retired lists on the calling thread
+    void drain()
+    {
+        list_of_lists retired;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            retired.swap(m_pending);
+        }
+        retired.clear();
+    }
+
+private:
+    using list_of_lists = forward_list2<list_type>;
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stop) {
+            if (m_pending.empty()) {
+                m_wakeup.wait(lock);
+                continue;
+            }
+
+            list_of_lists retired;
+            retired.swap(m_pending);
+            lock.unlock();
+            retired.clear();
+            lock.lock();
+        }
+    }
+
+    std::mutex              m_mutex;
+    std::condition_variable m_wakeup;
+    list_of_lists           m_pending;
+    bool                    m_stop;
+    std::thread             m_thread;
+};
+
+// Detaches the elements in O(1) and passes them to the reclaimer
+template<typename T, class Allocator>
+void clear_async(forward_list2<T, Allocator>& list, forward_list2_reclaimer<T, Allocator>& reclaimer)
+{
+    reclaimer.retire(list);
+}
+
+#endif // FORWARD_LIST_2_RECLAIMER_HPP
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FORWARD_LIST_2_SKIP_INDEX_HPP
+#define FORWARD_LIST_2_SKIP_INDEX_HPP
+
+#include "forward_list2.hpp"
+
+#include <algorithm>
+#include <vector>
+
+// Sparse index over a sorted forward_list2: the list is cut into segments
+// of [stride / 2, 2 * stride) nodes, except for the last one, and the heads
+// of the segments are kept in a sorted array. Searches are a binary search
+// over the heads plus a scan of at most one segment, O(log N + stride).
+// Splitting or merging a segment shifts the array, so insert_sorted and
+// erase are O(log N + stride + N / stride), with a small constant for the
+// last term.
+//
+// forward_list2 has no room for observers, so the sorted list has to be
+// modified through the index. Call rebuild() after modifying it directly.
+template<typename T, class Compare = std::less<T>, class Allocator = std::allocator<T>>
+class forward_list2_skip_index
+{
+public:
+    using list_type       = forward_list2<T, Allocator>;
+    using value_type      = T;
+    using size_type       = typename list_type::size_type;
+    using iterator        = typename list_type::iterator;
+    using const_iterator  = typename list_type::const_iterator;
+
+    explicit forward_list2_skip_index(list_type& list, Compare comp = Compare(), size_type stride = 32) :
+        m_list(list), m_comp(comp), m_stride(stride > 0 ? stride : 1)
+    {
+        rebuild();
+    }
+
+    list_type& list() noexcept { return m_list; }
+    const list_type& list() const noexcept { return m_list; }
+
+    size_type segments() const noexcept { return m_segments.size(); }
+
+    void rebuild()
+    {
+        m_segments.clear();
+        size_type count = 0;
+        for (auto it = m_list.cbegin(); it != m_list.cend(); ++it, ++count) {
+            if (count % m_stride == 0)
+                m_segments.push_back(segment{ it, 0 });
+            ++m_segments.back().size;
+        }
+    }
+
+    // Position after which the value would be inserted by insert_sorted
+    const_iterator lower_bound_before(const T& value) const { return locate(value).before; }
+
+    const_iterator lower_bound(const T& value) const { return std::next(lower_bound_before(value)); }
+
+    iterator insert_sorted(const T& value)
+    {
+        auto pos = locate(value);
+        return on_insertion(pos, m_list.insert_after(pos.before, value));
+    }
+
+    iterator insert_sorted(T&& value)
+    {
+        auto pos = locate(value);
+        return on_insertion(pos, m_list.insert_after(pos.before, std::move(value)));
+    }
+
+    // The value must not be less than the last element
+    void push_back(const T& value) { on_push_back(m_list.insert_after(m_list.before_end(), value)); }
+    void push_back(T&& value)      { on_push_back(m_list.insert_after(m_list.before_end(), std::move(value))); }
+
+    // Erases the first element equivalent to the value
+    bool erase(const T& value)
+    {
+        auto pos = locate(value);
+        auto it = std::next(pos.before);
+        if (it == m_list.cend() || m_comp(value, *it))
+            return false;
+
+        auto index = pos.index;
+        if (!pos.front && index + 1 < m_segments.size() && m_segments[index + 1].head == it)
+            ++index;
+
+        auto& seg = m_segments[index];
+        if (seg.head == it && seg.size == 1) {
+            m_segments.erase(m_segments.begin() + index);
+        }
+        else {
+            if (seg.head == it)
+                ++seg.head;
+            --seg.size;
+        }
+
+        // Merging may walk the segment, so the node is erased first
+        m_list.erase_after(pos.before);
+        if (index < m_segments.size() && m_segments[index].size < m_stride / 2)
+            merge(index);
+
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        m_list.clear();
+        m_segments.clear();
+    }
+
+private:
+    struct segment
+    {
+        const_iterator head;
+        size_type size;
+    };
+
+    struct position
+    {
+        size_type index;
+        const_iterator before;
+        bool front;
+    };
+
+    position locate(const T& value) const
+    {
+        auto seg = std::lower_bound(m_segments.begin(), m_segments.end(), value,
+            [this](const segment& s, const T& v){ return m_comp(*s.head, v); });
+
+        if (seg == m_segments.begin())
+            return position{ 0, m_list.cbefore_begin(), true };
+
+        --seg;
+        auto before = seg->head;
+        for (auto next = std::next(before); next != m_list.cend() && m_comp(*next, value); ++next)
+            before = next;
+
+        return position{ size_type(seg - m_segments.begin()), before, false };
+    }
+
+    iterator on_insertion(const position& pos, iterator it)
+    {
+        if (m_segments.empty()) {
+            m_segments.push_back(segment{ it, 1 });
+            return it;
+        }
+
+        auto& seg = m_segments[pos.index];
+        if (pos.front)
+            seg.head = it;
+
+        if (++seg.size >= 2 * m_stride)
+            split(pos.index);
+
+        return it;
+    }
+
+    void split(size_type index)
+    {
+        auto& seg = m_segments[index];
+        segment second{ std::next(seg.head, m_stride), seg.size - m_stride };
+        seg.size = m_stride;
+        m_segments.insert(m_segments.begin() + index + 1, second);
+    }
+
+    // Joins an undersized segment with its neighbour, splitting the result
+    // again if it is too long
+    void merge(size_type index)
+    {
+        if (m_segments.size() < 2)
+            return;
+
+        if (index + 1 == m_segments.size())
+            --index;
+
+        m_segments[index].size += m_segments[index + 1].size;
+        m_segments.erase(m_segments.begin() + index + 1);
+        if (m_segments[index].size >= 2 * m_stride)
+            split(index);
+    }
+
+    void on_push_back(const_iterator it)
+    {
+        if (m_segments.empty() || m_segments.back().size >= m_stride)
+            m_segments.push_back(segment{ it, 1 });
+        else
+            ++m_segments.back().size;
+    }
+
+    list_type&           m_list;
+    Compare              m_comp;
+    size_type            m_stride;
+    std::vector<segment> m_segments;
+};
+
+#endif // FORWARD_LIST_2_SKIP_INDEX_HPP
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+
+#ifndef FORWARD_LIST_2_SPSC_HPP
+#define FORWARD_LIST_2_SPSC_HPP
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Unbounded queue for one producer thread and one consumer thread.
+// Nodes are singly linked as in forward_list2: the producer appends after
+// the tail, and the consumer pops after a dummy head. Popped nodes are
+// reused by the producer, so in steady state there are no allocations
+// and both push_back and try_pop are wait-free.
+template<typename T, class Allocator = std::allocator<T>>
+class spsc_forward_list2
+{
+    struct node
+    {
+        std::atomic<node*> next;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() noexcept { return reinterpret_cast<T*>(storage); }
+    };
+
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<node>;
+    using node_traits    = std::allocator_traits<node_allocator>;
+
+public:
+    using value_type     = T;
+    using allocator_type = Allocator;
+
+    explicit spsc_forward_list2(const Allocator& alloc = Allocator()) :
+        m_alloc(alloc)
+    {
+        auto dummy = allocate_node();
+        m_head.pointer.store(dummy, std::memory_order_relaxed);
+        m_tail = m_first = m_head_copy = dummy;
+    }
+
+    spsc_forward_list2(const spsc_forward_list2&) = delete;
+    spsc_forward_list2& operator=(const spsc_forward_list2&) = delete;
+
+    ~spsc_forward_list2()
+    {
+        auto head = m_head.pointer.load(std::memory_order_relaxed);
+        for (auto n = head->next.load(std::memory_order_relaxed); n != nullptr; n = n->next.load(std::memory_order_relaxed))
+            n->value()->~T();
+
+        // Nodes from the oldest passed one to the tail are still linked
+        for (auto n = m_first; n != nullptr; ) {
+            auto next = n->next.load(std::memory_order_relaxed);
+            node_traits::deallocate(m_alloc, n, 1);
+            n = next;
+        }
+    }
+
+    // Producer side
+    template<class... Args>
+    void emplace_back(Args&&... args)
+    {
+        auto n = get_node();
+        try {
+            ::new (static_cast<void*>(n->value())) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            node_traits::deallocate(m_alloc, n, 1);
+            throw;
+        }
+        m_tail->next.store(n, std::memory_order_release);
+        m_tail = n;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value)      { emplace_back(std::move(value)); }
+
+    // Consumer side
+    bool try_pop(T& value)
+    {
+        auto head = m_head.pointer.load(std::memory_order_relaxed);
+        auto next = head->next.load(std::memory_order_acquire);
+        if (next == nullptr)
+            return false;
+
+        // The popped node becomes the dummy head, the old one may be reused
+        value = std::move(*next->value());
+        next->value()->~T();
+        m_head.pointer.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // May be called by the consumer only
+    bool empty() const noexcept
+    {
+        return m_head.pointer.load(std::memory_order_relaxed)->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    node* allocate_node()
+    {
+        auto n = ::new (static_cast<void*>(node_traits::allocate(m_alloc, 1))) node;
+        n->next.store(nullptr, std::memory_order_relaxed);
+        return n;
+    }
+
+    // Reuses the nodes which the consumer has passed, allocates only if there are none
+    node* get_node()
+    {
+        if (m_first == m_head_copy)
+            m_head_copy = m_head.pointer.load(std::memory_order_acquire);
+        if (m_first == m_head_copy)
+            return allocate_node();
+
+        auto n = m_first;
+        m_first = m_first->next.load(std::memory_order_relaxed);
+        n->next.store(nullptr, std::memory_order_relaxed);
+        return n;
+    }
+
+    // Consumer data, kept apart from the producer data to avoid false sharing
+    struct padded_head
+    {
+        std::atomic<node*> pointer;
+        char padding[64];
+    };
+
+    padded_head        m_head;
+
+    // Producer data
+    node*              m_tail;
+    node*              m_first;
+    node*              m_head_copy;
+    node_allocator     m_alloc;
+};
+
+#endif // FORWARD_LIST_2_SPSC_HPP
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FORWARD_LIST_2_TRACKING_ALLOCATOR_HPP
+#define FORWARD_LIST_2_TRACKING_ALLOCATOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// Memory usage counters, shared by all copies of a tracking allocator
+class forward_list2_allocation_stats
+{
+public:
+    forward_list2_allocation_stats() = default;
+    forward_list2_allocation_stats(const forward_list2_allocation_stats&) = delete;
+    forward_list2_allocation_stats& operator=(const forward_list2_allocation_stats&) = delete;
+
+    std::size_t live_bytes()     const noexcept { return m_live_bytes.load(std::memory_order_relaxed); }
+    std::size_t peak_bytes()     const noexcept { return m_peak_bytes.load(std::memory_order_relaxed); }
+    std::size_t live_footprint() const noexcept { return m_live_footprint.load(std::memory_order_relaxed); }
+
+    // Each node of a list is a separate block
+    std::size_t live_blocks()  const noexcept { return m_live_blocks.load(std::memory_order_relaxed); }
+    std::size_t total_blocks() const noexcept { return m_total_blocks.load(std::memory_order_relaxed); }
+
+    std::size_t bytes_per_block() const noexcept
+    {
+        auto blocks = live_blocks();
+        return blocks == 0 ? 0 : live_bytes() / blocks;
+    }
+
+    std::size_t footprint_per_block() const noexcept
+    {
+        auto blocks = live_blocks();
+        return blocks == 0 ? 0 : live_footprint() / blocks;
+    }
+
+    // Estimated size of a heap block for the given request: a size header,
+    // rounding to 2 * sizeof(void*), and a minimum block size, as in ptmalloc
+    static std::size_t footprint(std::size_t bytes) noexcept
+    {
+        const std::size_t granule = 2 * sizeof(void*);
+        return std::max(2 * granule, (bytes + sizeof(void*) + granule - 1) / granule * granule);
+    }
+
+    void on_allocate(std::size_t bytes) noexcept
+    {
+        auto live = m_live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        auto peak = m_peak_bytes.load(std::memory_order_relaxed);
+        while (peak < live && !m_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) { }
+
+        m_live_footprint.fetch_add(footprint(bytes), std::memory_order_relaxed);
+        m_live_blocks.fetch_add(1, std::memory_order_relaxed);
+        m_total_blocks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void on_deallocate(std::size_t bytes) noexcept
+    {
+        m_live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+        m_live_footprint.fetch_sub(footprint(bytes), std::memory_order_relaxed);
+        m_live_blocks.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::size_t> m_live_bytes{ 0 };
+    std::atomic<std::size_t> m_peak_bytes{ 0 };
+    std::atomic<std::size_t> m_live_footprint{ 0 };
+    std::atomic<std::size_t> m_live_blocks{ 0 };
+    std::atomic<std::size_t> m_total_blocks{ 0 };
+};
+
+// Counters shared by all the allocators with the same tag
+template<typename Tag>
+forward_list2_allocation_stats& forward_list2_tag_stats()
+{
+    static forward_list2_allocation_stats stats;
+    return stats;
+}
+
+// Allocator adaptor which records allocations of the upstream allocator.
+// Default-constructed allocators count into the stats of their Tag,
+// to count per container pass a separate stats object to the constructor.
+template<typename T, class Allocator = std::allocator<T>, typename Tag = void>
+class forward_list2_tracking_allocator
+{
+    using traits = std::allocator_traits<Allocator>;
+
+public:
+    using value_type         = T;
+    using pointer            = typename traits::pointer;
+    using const_pointer      = typename traits::const_pointer;
+    using void_pointer       = typename traits::void_pointer;
+    using const_void_pointer = typename traits::const_void_pointer;
+    using size_type          = typename traits::size_type;
+    using difference_type    = typename traits::difference_type;
+
+    using propagate_on_container_copy_assignment = typename traits::propagate_on_container_copy_assignment;
+    using propagate_on_container_move_assignment = typename traits::propagate_on_container_move_assignment;
+    using propagate_on_container_swap            = typename traits::propagate_on_container_swap;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = forward_list2_tracking_allocator<U, typename traits::template rebind_alloc<U>, Tag>;
+    };
+
+    forward_list2_tracking_allocator() :
+        m_stats(&forward_list2_tag_stats<Tag>()), m_upstream()
+    { }
+
+    explicit forward_list2_tracking_allocator(forward_list2_allocation_stats& stats, const Allocator& upstream = Allocator()) :
+        m_stats(&stats), m_upstream(upstream)
+    { }
+
+    template<typename U, class UAllocator>
+    forward_list2_tracking_allocator(const forward_list2_tracking_allocator<U, UAllocator, Tag>& other) :
+        m_stats(&other.stats()), m_upstream(other.upstream())
+    { }
+
+    pointer allocate(size_type n)
+    {
+        auto p = traits::allocate(m_upstream, n);
+        m_stats->on_allocate(n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        traits::deallocate(m_upstream, p, n);
+        m_stats->on_deallocate(n * sizeof(T));
+    }
+
+    forward_list2_allocation_stats& stats() const noexcept { return *m_stats; }
+    const Allocator& upstream() const noexcept { return m_upstream; }
+
+    template<typename U, class UAllocator>
+    bool operator==(const forward_list2_tracking_allocator<U, UAllocator, Tag>& rhs) const noexcept
+    {
+        return m_stats == &rhs.stats() && m_upstream == rhs.upstream();
+    }
+
+    template<typename U, class UAllocator>
+    bool operator!=(const forward_list2_tracking_allocator<U, UAllocator, Tag>& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+private:
+    forward_list2_allocation_stats* m_stats;
+    Allocator                       m_upstream;
+};
+
+#endif // FORWARD_LIST_2_TRACKING_ALLOCATOR_HPP
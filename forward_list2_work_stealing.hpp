@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2021-2022 Pavel I. Kryukov
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+ 
+
+#ifndef FORWARD_LIST_2_WORK_STEALING_HPP
+#define FORWARD_LIST_2_WORK_STEALING_HPP
+
+#include "forward_list2.hpp"
+
+#include <memory>
+#include <mutex>
+
+// Set of FIFO queues, one per worker. A worker pushes to and pops from
+// its own queue; when it is empty, it steals the front half of another
+// worker's queue as a whole chain. The victim is locked only to take its
+// whole queue and to return the back half, both in O(1).
+template<typename T, class Allocator = std::allocator<T>>
+class work_stealing_forward_list2
+{
+public:
+    using list_type = forward_list2<T, Allocator>;
+    using size_type = typename list_type::size_type;
+
+    explicit work_stealing_forward_list2(size_type workers, const Allocator& alloc = Allocator()) :
+        m_queues(new queue[workers]), m_workers(workers)
+    {
+        for (size_type i = 0; i < workers; ++i)
+            m_queues[i].list = list_type(alloc);
+    }
+
+    size_type workers() const noexcept { return m_workers; }
+
+    template<class... Args>
+    void emplace_back(size_type worker, Args&&... args)
+    {
+        auto& q = m_queues[worker];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.list.emplace_back(std::forward<Args>(args)...);
+        ++q.size;
+    }
+
+    void push_back(size_type worker, const T& value) { emplace_back(worker, value); }
+    void push_back(size_type worker, T&& value)      { emplace_back(worker, std::move(value)); }
+
+    // Pops the front of the worker's queue, or steals from the other queues
+    // if it is empty. Returns false if no task was found. A thief splits
+    // a stolen queue without holding its lock, so the queue looks empty
+    // meanwhile: false does not mean that all the tasks are done, and
+    // termination has to be detected by counting the pending tasks.
+    bool try_pop(size_type worker, T& value)
+    {
+        auto& q = m_queues[worker];
+        if (pop_local(q, value))
+            return true;
+
+        for (size_type i = 1; i < m_workers; ++i)
+            if (steal(q, m_queues[(worker + i) % m_workers], value))
+                return true;
+
+        return false;
+    }
+
+private:
+    struct queue
+    {
+        std::mutex mutex;
+        list_type  list;
+        size_type  size = 0;
+
+        // Keeps queues of different workers in different cache lines
+        char padding[64];
+    };
+
+    static bool pop_local(queue& q, T& value)
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.list.empty())
+            return false;
+
+        value = std::move(q.list.front());
+        q.list.pop_front();
+        --q.size;
+        return true;
+    }
+
+    static bool steal(queue& thief, queue& victim, T& value)
+    {
+        std::unique_lock<std::mutex> lock(victim.mutex);
+        if (victim.list.empty())
+            return false;
+
+        // The whole queue is taken in O(1) and split without the lock
+        list_type chain(victim.list.get_allocator());
+        chain.swap(victim.list);
+        const auto size = victim.size;
+        victim.size = 0;
+        lock.unlock();
+
+        auto count = (size + 1) / 2;
+        auto stolen = chain.detach_front(count);
+        if (!chain.empty()) {
+            // The back half is returned unless the victim got new work meanwhile
+            lock.lock();
+            if (victim.list.empty()) {
+                victim.list.swap(chain);
+                victim.size = size - count;
+            }
+            lock.unlock();
+            if (!chain.empty()) {
+                stolen.splice_after(stolen.before_end(), chain);
+                count = size;
+            }
+        }
+
+        value = std::move(stolen.front());
+        stolen.pop_front();
+        if (stolen.empty())
+            return true;
+
+        // Only the owner pushes to its queue, so it is normally still empty
+        // and the chain is taken over without walking it
+        std::lock_guard<std::mutex> thief_lock(thief.mutex);
+        thief.list.splice_after(thief.list.before_begin(), stolen);
+        thief.size += count - 1;
+        return true;
+    }
+
+    std::unique_ptr<queue[]> m_queues;
+    size_type                m_workers;
+};
+
+#endif // FORWARD_LIST_2_WORK_STEALING_HPP
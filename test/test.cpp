@@ -20,11 +20,42 @@
  * SOFTWARE.
  */
 
+#include <cstddef>
+
+static std::size_t tail_walk_steps = 0;
+
+#define FORWARD_LIST2_ON_TAIL_WALK_STEP() (++tail_walk_steps)
+
 #include "../forward_list2.hpp"
+#include "../forward_list2_arena.hpp"
+#include "../forward_list2_channel.hpp"
+#include "../forward_list2_collector.hpp"
+#include "../forward_list2_cow.hpp"
+#include "../forward_list2_parallel.hpp"
+#include "../forward_list2_queue.hpp"
+#include "../forward_list2_reclaimer.hpp"
+#include "../forward_list2_tracking_allocator.hpp"
+#include "../forward_list2_work_stealing.hpp"
+#include "../forward_list2_skip_index.hpp"
+#include "../forward_list2_spsc.hpp"
 
 #include <gtest/gtest.h>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #ifdef __cpp_lib_as_const
 
@@ -114,6 +145,14 @@ TEST_F(ForwardList, CounterInit)
     check_iterators(l);
 }
 
+TEST_F(ForwardList, CounterDefaultInit)
+{
+    forward_list2<int> l(3);
+
+    EXPECT_EQ(l, (forward_list2<int>{ 0, 0, 0 }));
+    check_iterators(l);
+}
+
 TEST_F(ForwardList, IteratorInit)
 {
     const std::vector<int> v{ 1, 2, 3, 4, 5 };
@@ -166,6 +205,25 @@ TEST_F(ForwardList, Move)
     check_ranged_list(l2, 5);
 }
 
+TEST_F(ForwardList, MoveEmpty)
+{
+    forward_list2<int> l1;
+    auto l2 = std::move(l1);
+
+    check_empty_list(l1);
+    check_empty_list(l2);
+}
+
+TEST_F(ForwardList, MoveAssignEmpty)
+{
+    forward_list2<int> l1;
+    forward_list2<int> l2({ 1, 2, 3 });
+    l2 = std::move(l1);
+
+    check_empty_list(l1);
+    check_empty_list(l2);
+}
+
 TEST_F(ForwardList, MoveAllocator)
 {
     forward_list2<int> l1{ 1, 2, 3, 4, 5 };
@@ -422,6 +480,36 @@ TEST_F(ForwardList, EmplaceFrontAndBack)
     check_ranged_list(l, 3);
 }
 
+TEST_F(ForwardList, EmplaceBackN)
+{
+    forward_list2<std::string> l{ "a" };
+    l.emplace_back_n(3, 2, 'b');
+    l.emplace_back_n(0, 2, 'c');
+    l.emplace_back_n(1);
+
+    EXPECT_EQ(l, (forward_list2<std::string>{ "a", "bb", "bb", "bb", "" }));
+    EXPECT_EQ(l.back(), "");
+    EXPECT_EQ(std::next(l.before_end()), l.end());
+}
+
+TEST_F(ForwardList, GenerateBack)
+{
+    forward_list2<int> l{ 1, 2 };
+    int counter = 2;
+    l.generate_back(4, [&counter](){ return ++counter; });
+
+    check_ranged_list(l, 6);
+}
+
+TEST_F(ForwardList, GenerateBackToEmpty)
+{
+    forward_list2<int> l;
+    int counter = 0;
+    l.generate_back(3, [&counter](){ return ++counter; });
+
+    check_ranged_list(l, 3);
+}
+
 TEST_F(ForwardList, PopFront)
 {
     forward_list2<int> l({ 0, 1, 2, 3 });
@@ -449,6 +537,17 @@ TEST_F(ForwardList, ResizeIncrease)
     check_iterators(l);
 }
 
+TEST_F(ForwardList, ResizeMoveOnly)
+{
+    forward_list2<std::unique_ptr<int>> l;
+    l.resize(3);
+    l.resize(2);
+
+    EXPECT_EQ(std::distance(l.begin(), l.end()), 2);
+    EXPECT_EQ(std::next(l.before_end()), l.end());
+    EXPECT_EQ(l.back(), nullptr);
+}
+
 TEST_F(ForwardList, ResizeDecrease)
 {
     forward_list2<int> l({ 1, 2, 3, 4, 5, 6, 7 });
@@ -485,6 +584,16 @@ TEST_F(ForwardList, Swap)
     check_ranged_list(l2, 7);
 }
 
+TEST_F(ForwardList, SwapEmpty)
+{
+    forward_list2<int> l1({ 1, 2, 3 });
+    forward_list2<int> l2;
+    l1.swap(l2);
+
+    check_empty_list(l1);
+    check_ranged_list(l2, 3);
+}
+
 TEST_F(ForwardList, StdSwap)
 {
     forward_list2<int> l1({ 1, 2, 3, 4, 5, 6, 7 });
@@ -548,6 +657,28 @@ TEST_F(ForwardList, SpliceWhole)
     check_empty_list(l2);
 }
 
+TEST_F(ForwardList, SpliceWholeEmpty)
+{
+    forward_list2<int> l1({ 1, 2, 3 });
+    forward_list2<int> l2;
+
+    l1.splice_after(l1.before_end(), l2);
+    check_ranged_list(l1, 3);
+    check_empty_list(l2);
+}
+
+TEST_F(ForwardList, SpliceWholeToEmpty)
+{
+    forward_list2<int> l1;
+    forward_list2<int> l2({ 1, 2, 3 });
+    const auto tail = l2.before_end();
+
+    l1.splice_after(l1.before_begin(), l2);
+    check_ranged_list(l1, 3);
+    check_empty_list(l2);
+    EXPECT_EQ(l1.before_end(), tail);
+}
+
 TEST_F(ForwardList, SpliceWholeMove)
 {
     forward_list2<int> l({ 1, 5, 6, 7 });
@@ -668,6 +799,87 @@ TEST_F(ForwardList, SpliceRangeToSelf)
     check_ranged_list(l, 7);
 }
 
+TEST_F(ForwardList, SplitAfter)
+{
+    forward_list2<int> l1({ 1, 2, 3, 1, 2 });
+    auto l2 = l1.split_after(std::next(l1.begin(), 2));
+
+    check_ranged_list(l1, 3);
+    check_ranged_list(l2, 2);
+}
+
+TEST_F(ForwardList, SplitAfterBeforeBegin)
+{
+    forward_list2<int> l1({ 1, 2, 3 });
+    auto l2 = l1.split_after(l1.before_begin());
+
+    check_empty_list(l1);
+    check_ranged_list(l2, 3);
+}
+
+TEST_F(ForwardList, SplitAfterEnd)
+{
+    forward_list2<int> l1({ 1, 2, 3 });
+    auto l2 = l1.split_after(l1.before_end());
+
+    check_ranged_list(l1, 3);
+    check_empty_list(l2);
+}
+
+TEST_F(ForwardList, SplitAfterEmpty)
+{
+    forward_list2<int> l1;
+    auto l2 = l1.split_after(l1.before_begin());
+
+    check_empty_list(l1);
+    check_empty_list(l2);
+}
+
+TEST_F(ForwardList, DetachFront)
+{
+    forward_list2<int> l1({ 1, 2, 3, 1, 2 });
+    auto l2 = l1.detach_front(3);
+
+    check_ranged_list(l1, 2);
+    check_ranged_list(l2, 3);
+}
+
+TEST_F(ForwardList, DetachFrontNothing)
+{
+    forward_list2<int> l1({ 1, 2, 3 });
+    auto l2 = l1.detach_front(0);
+
+    check_ranged_list(l1, 3);
+    check_empty_list(l2);
+}
+
+TEST_F(ForwardList, DetachFrontAll)
+{
+    forward_list2<int> l1({ 1, 2, 3 });
+    auto l2 = l1.detach_front(5);
+
+    check_empty_list(l1);
+    check_ranged_list(l2, 3);
+}
+
+TEST_F(ForwardList, DetachFrontWhile)
+{
+    forward_list2<int> l1({ 1, 2, 3, 4, 5 });
+    auto l2 = l1.detach_front_while([](int x){ return x < 3; });
+    auto l3 = l1.detach_front_while([](int x){ return x < 3; });
+
+    EXPECT_EQ(l1, (forward_list2<int>{ 3, 4, 5 }));
+    check_iterators(l1);
+    check_ranged_list(l2, 2);
+    check_empty_list(l3);
+
+    auto l4 = l1.detach_front_while([](int x){ return x > 2; });
+
+    check_empty_list(l1);
+    EXPECT_EQ(l4, (forward_list2<int>{ 3, 4, 5 }));
+    check_iterators(l4);
+}
+
 TEST_F(ForwardList, Remove)
 {
     forward_list2<int> l({ 1, 0, 2, 0, 3, 0});
@@ -684,6 +896,76 @@ TEST_F(ForwardList, RemovePredicate)
     check_ranged_list(l, 3);
 }
 
+TEST_F(ForwardList, Partition)
+{
+    forward_list2<int> l1({ 1, 10, 2, 20, 30, 3 });
+    auto l2 = l1.partition([](int x){ return x >= 10; });
+
+    EXPECT_EQ(l2, (forward_list2<int>{ 10, 20, 30 }));
+    check_ranged_list(l1, 3);
+    check_iterators(l2);
+}
+
+TEST_F(ForwardList, PartitionLast)
+{
+    forward_list2<int> l1({ 1, 2, 3, 10, 20 });
+    auto l2 = l1.partition([](int x){ return x >= 10; });
+
+    EXPECT_EQ(l2, (forward_list2<int>{ 10, 20 }));
+    check_ranged_list(l1, 3);
+    check_iterators(l2);
+}
+
+TEST_F(ForwardList, PartitionAll)
+{
+    forward_list2<int> l1({ 1, 2, 3 });
+    auto l2 = l1.partition([](int){ return true; });
+
+    check_empty_list(l1);
+    check_ranged_list(l2, 3);
+}
+
+TEST_F(ForwardList, PartitionNone)
+{
+    forward_list2<int> l1({ 1, 2, 3 });
+    auto l2 = l1.partition([](int){ return false; });
+
+    check_ranged_list(l1, 3);
+    check_empty_list(l2);
+}
+
+TEST_F(ForwardList, StablePartition)
+{
+    forward_list2<int> l({ 4, 1, 5, 2, 3 });
+    auto it = l.stable_partition([](int x){ return x < 4; });
+
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(l, (forward_list2<int>{ 1, 2, 3, 4, 5 }));
+    check_iterators(l);
+}
+
+TEST_F(ForwardList, StablePartitionNone)
+{
+    forward_list2<int> l({ 1, 2, 3 });
+    auto it = l.stable_partition([](int x){ return x > 3; });
+
+    EXPECT_EQ(it, l.before_begin());
+    check_ranged_list(l, 3);
+}
+
+TEST_F(ForwardList, StablePartitionAll)
+{
+    forward_list2<int> l({ 1, 2, 3 });
+    auto it = l.stable_partition([](int){ return true; });
+
+    EXPECT_EQ(it, l.before_end());
+    check_ranged_list(l, 3);
+
+    forward_list2<int> empty;
+    EXPECT_EQ(empty.stable_partition([](int){ return true; }), empty.before_begin());
+    check_empty_list(empty);
+}
+
 #ifdef __cpp_lib_erase_if
 TEST_F(ForwardList, StdErase)
 {
@@ -718,6 +1000,14 @@ TEST_F(ForwardList, Unique)
     check_ranged_list(l, 4);
 }
 
+TEST_F(ForwardList, UniqueEmpty)
+{
+    forward_list2<int> l;
+    l.unique();
+
+    check_empty_list(l);
+}
+
 TEST_F(ForwardList, UniquePredicate)
 {
     forward_list2<int> l({ 1, -1, 2, -2, 3, -3});
@@ -734,6 +1024,105 @@ TEST_F(ForwardList, Sort)
     check_ranged_list(l, 6);
 }
 
+TEST_F(ForwardList, SortPushBack)
+{
+    forward_list2<int> l({ 5, 3, 1, 2, 4 });
+    l.sort();
+    l.push_back(6);
+
+    check_ranged_list(l, 6);
+}
+
+TEST_F(ForwardList, SortRemove)
+{
+    forward_list2<int> l({ 5, 3, 1, 7, 2, 4, 6 });
+    l.sort();
+    l.remove(7);
+
+    check_ranged_list(l, 6);
+}
+
+TEST_F(ForwardList, SortMerge)
+{
+    forward_list2<int> l1({ 5, 1, 3 });
+    forward_list2<int> l2({ 6, 2, 4 });
+    l1.sort();
+    l2.sort();
+    l1.merge(l2);
+
+    check_ranged_list(l1, 6);
+    check_empty_list(l2);
+}
+
+TEST_F(ForwardList, SortSplitAfter)
+{
+    forward_list2<int> l1({ 5, 1, 3, 4, 2 });
+    l1.sort();
+    auto l2 = l1.split_after(std::next(l1.begin(), 2));
+    auto l3 = l2.split_after(l2.begin());
+
+    check_ranged_list(l1, 3);
+    EXPECT_EQ(l2, (forward_list2<int>{ 4 }));
+    EXPECT_EQ(l3, (forward_list2<int>{ 5 }));
+    check_iterators(l2);
+    check_iterators(l3);
+}
+
+TEST_F(ForwardList, CopyAssignMove)
+{
+    forward_list2<int> l1({ 1, 2, 3 });
+    forward_list2<int> l2;
+    l2 = l1;
+    auto l3 = std::move(l2);
+    l3.emplace_back(4);
+
+    check_empty_list(l2);
+    check_ranged_list(l3, 4);
+}
+
+TEST_F(ForwardList, SortStable)
+{
+    forward_list2<int> l({ 10, 21, 30, 11, 20, 31 });
+    l.sort([](int x, int y){ return x / 10 < y / 10; });
+
+    EXPECT_EQ(l, (forward_list2<int>{ 10, 11, 21, 20, 30, 31 }));
+    check_iterators(l);
+}
+
+TEST_F(ForwardList, SortManyRuns)
+{
+    forward_list2<int> l;
+    for (int i = 0; i < 100; ++i)
+        l.push_front(i);
+    l.sort();
+    l.push_back(100);
+
+    EXPECT_EQ(l.front(), 0);
+    EXPECT_EQ(l.back(), 100);
+    check_iterators(l);
+}
+
+TEST_F(ForwardList, MergeBefore)
+{
+    forward_list2<int> l1({ 4, 5 });
+    forward_list2<int> l2({ 1, 2, 3 });
+
+    l1.merge(l2);
+    check_ranged_list(l1, 5);
+    check_empty_list(l2);
+}
+
+TEST_F(ForwardList, MergeAfter)
+{
+    forward_list2<int> l1({ 1, 2, 3 });
+    forward_list2<int> l2({ 3, 4, 5 });
+
+    l1.merge(l2, [](int x, int y){ return x < y; });
+    EXPECT_EQ(l1, (forward_list2<int>{ 1, 2, 3, 3, 4, 5 }));
+    check_iterators(l1);
+    check_empty_list(l2);
+}
+
 TEST_F(ForwardList, SortReverse)
 {
     forward_list2<int> l({ 5, 6, 1, 3, 2, 4 });
@@ -743,6 +1132,75 @@ TEST_F(ForwardList, SortReverse)
     check_ranged_list(l, 6);
 }
 
+TEST_F(ForwardList, RadixSort)
+{
+    forward_list2<int> l({ 5, 6, 1, 3, 2, 4 });
+    l.radix_sort();
+
+    check_ranged_list(l, 6);
+}
+
+TEST_F(ForwardList, RadixSortSigned)
+{
+    forward_list2<int> l({ 300, -1, 0, -70000, 2, -300, 70000 });
+    l.radix_sort();
+
+    EXPECT_EQ(l, (forward_list2<int>{ -70000, -300, -1, 0, 2, 300, 70000 }));
+    check_iterators(l);
+}
+
+TEST_F(ForwardList, RadixSortUnsigned)
+{
+    forward_list2<unsigned long long> l({ 1ULL << 40, 7, 1ULL << 63, 0, 256 });
+    l.radix_sort();
+
+    EXPECT_EQ(l, (forward_list2<unsigned long long>{ 0, 7, 256, 1ULL << 40, 1ULL << 63 }));
+    EXPECT_EQ(l.back(), 1ULL << 63);
+    EXPECT_EQ(std::next(l.before_end()), l.end());
+}
+
+TEST_F(ForwardList, RadixSortKey)
+{
+    forward_list2<int> l({ 22, 11, 21, 12 });
+    l.radix_sort([](int x){ return static_cast<unsigned char>(x / 10); });
+
+    EXPECT_EQ(l, (forward_list2<int>{ 11, 12, 22, 21 }));
+    check_iterators(l);
+}
+
+TEST_F(ForwardList, RadixSortReverse)
+{
+    forward_list2<int> l({ 5, 6, 1, 3, 2, 4 });
+    l.radix_sort([](int x){ return -x; });
+    l.reverse();
+
+    check_ranged_list(l, 6);
+}
+
+TEST_F(ForwardList, RadixSortException)
+{
+    forward_list2<int> l({ 5, 6, 1, 3, 2, 4 });
+    int calls = 0;
+    // Throws in the middle of the distribution, after 7 calls to find the varying bytes
+    EXPECT_THROW(l.radix_sort([&calls](int x) {
+        if (++calls == 10)
+            throw std::runtime_error("key");
+        return x;
+    }), std::runtime_error);
+
+    EXPECT_EQ(std::distance(l.begin(), l.end()), 6);
+    l.sort();
+    check_ranged_list(l, 6);
+}
+
+TEST_F(ForwardList, RadixSortEmpty)
+{
+    forward_list2<int> l;
+    l.radix_sort();
+
+    check_empty_list(l);
+}
+
 TEST_F(ForwardList, Spaceship)
 {
     forward_list2<int> a{1, 2, 3};
@@ -811,3 +1269,1443 @@ TEST_F(ForwardList, SpliceEmptyToEmpty)
 
     check_empty_list(l);
 }
+
+TEST_F(ForwardList, SkipIndexInsertSorted)
+{
+    forward_list2<int> l;
+    forward_list2_skip_index<int> index(l, std::less<int>(), 4);
+    for (int i = 0; i < 100; ++i)
+        index.insert_sorted((i * 37) % 100 + 1);
+
+    check_ranged_list(l, 100);
+    for (int i = 1; i <= 100; ++i)
+        EXPECT_EQ(*index.lower_bound(i), i);
+
+    EXPECT_EQ(index.lower_bound(101), l.end());
+    EXPECT_EQ(index.lower_bound_before(1), l.before_begin());
+}
+
+TEST_F(ForwardList, SkipIndexErase)
+{
+    forward_list2<int> l;
+    forward_list2_skip_index<int> index(l, std::less<int>(), 2);
+    for (int i = 1; i <= 20; ++i)
+        index.push_back(i);
+    for (int i = 20; i > 10; --i)
+        index.insert_sorted(i);
+
+    for (int i = 11; i <= 20; ++i)
+        EXPECT_TRUE(index.erase(i));
+    EXPECT_FALSE(index.erase(0));
+    EXPECT_FALSE(index.erase(30));
+    check_ranged_list(l, 20);
+
+    for (int i = 1; i <= 20; i += 2)
+        EXPECT_TRUE(index.erase(i));
+    for (int i = 2; i <= 20; i += 2)
+        EXPECT_EQ(*index.lower_bound(i - 1), i);
+
+    for (int i = 20; i > 0; i -= 2)
+        EXPECT_TRUE(index.erase(i));
+    EXPECT_FALSE(index.erase(2));
+    check_empty_list(l);
+}
+
+TEST_F(ForwardList, SkipIndexMerge)
+{
+    forward_list2<int> l;
+    forward_list2_skip_index<int> index(l, std::less<int>(), 4);
+    for (int i = 1; i <= 40; ++i)
+        index.push_back(i);
+    EXPECT_EQ(index.segments(), 10);
+
+    // Segments of a single node are merged with their neighbours
+    for (int i = 1; i <= 40; ++i) {
+        if (i % 4 != 0) {
+            EXPECT_TRUE(index.erase(i));
+        }
+    }
+    EXPECT_LE(index.segments(), 6);
+
+    for (int i = 4; i <= 40; i += 4)
+        EXPECT_EQ(*index.lower_bound(i - 3), i);
+    EXPECT_EQ(std::distance(l.begin(), l.end()), 10);
+    EXPECT_EQ(l.back(), 40);
+}
+
+TEST_F(ForwardList, SkipIndexRebuild)
+{
+    forward_list2<int> l{ 1, 2, 3, 5 };
+    forward_list2_skip_index<int> index(l, std::less<int>(), 1);
+    l.push_back(6);
+    l.push_front(0);
+    index.rebuild();
+    index.insert_sorted(4);
+    index.erase(0);
+
+    check_ranged_list(l, 6);
+}
+
+#ifdef __cpp_impl_coroutine
+static forward_list2_executor::task produce(forward_list2_executor& executor, forward_list2_channel<int>& channel)
+{
+    for (int i = 1; i <= 3; ++i)
+        channel.push_back(i);
+
+    co_await executor.yield();
+    channel.push_back(4);
+    channel.emplace_back(5);
+}
+
+static forward_list2_executor::task consume(forward_list2_channel<int>& channel, forward_list2<int>& result)
+{
+    for (int i = 0; i < 5; ++i)
+        result.push_back(co_await channel.pop());
+}
+
+static forward_list2_executor::task consume_batches(forward_list2_channel<int>& channel, forward_list2<int>& result, int& batches)
+{
+    while (result.empty() || result.back() < 5) {
+        auto batch = co_await channel.pop_batch(2);
+        result.splice_after(result.before_end(), batch);
+        ++batches;
+    }
+}
+
+TEST_F(ForwardList, ChannelPop)
+{
+    forward_list2_executor executor;
+    forward_list2_channel<int> channel(executor);
+    forward_list2<int> result;
+
+    executor.spawn(consume(channel, result));
+    executor.spawn(produce(executor, channel));
+    executor.run();
+
+    check_ranged_list(result, 5);
+    EXPECT_TRUE(channel.empty());
+}
+
+TEST_F(ForwardList, ChannelPopBatch)
+{
+    forward_list2_executor executor;
+    forward_list2_channel<int> channel(executor);
+    forward_list2<int> result;
+    int batches = 0;
+
+    executor.spawn(produce(executor, channel));
+    executor.spawn(consume_batches(channel, result, batches));
+    executor.run();
+
+    // { 1, 2 }, { 3 }, { 4 }, { 5 }
+    EXPECT_EQ(batches, 4);
+    check_ranged_list(result, 5);
+    EXPECT_TRUE(channel.empty());
+}
+
+TEST_F(ForwardList, ChannelUnfinished)
+{
+    forward_list2_executor executor;
+    forward_list2_channel<int> channel(executor);
+    forward_list2<int> result;
+
+    executor.spawn(consume(channel, result));
+    executor.run();
+    channel.push_back(1);
+
+    EXPECT_TRUE(result.empty());
+    EXPECT_TRUE(executor.run_one());
+    check_ranged_list(result, 1);
+    EXPECT_FALSE(executor.run_one());
+}
+#endif
+
+static void fill_collector(forward_list2_collector<int>& collector)
+{
+    // Shard 2 is left empty
+    const int ranges[][2] = { { 1, 3 }, { 4, 8 }, { 9, 8 }, { 9, 10 } };
+    std::vector<std::thread> workers;
+    for (std::size_t shard = 0; shard < collector.shards(); ++shard) {
+        workers.emplace_back([&collector, &ranges, shard](){
+            for (int i = ranges[shard][0]; i <= ranges[shard][1]; ++i)
+                collector.emplace_back(shard, i);
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+}
+
+TEST_F(ForwardList, Collector)
+{
+    forward_list2_collector<int> collector(4);
+    fill_collector(collector);
+    auto l = collector.collect();
+
+    auto empty = collector.collect();
+
+    check_ranged_list(l, 10);
+    check_empty_list(empty);
+}
+
+TEST_F(ForwardList, CollectorUnordered)
+{
+    forward_list2_collector<int> collector(4);
+    fill_collector(collector);
+    auto l = collector.collect_unordered();
+
+    EXPECT_EQ(l, (forward_list2<int>{ 4, 5, 6, 7, 8, 1, 2, 3, 9, 10 }));
+    auto empty = collector.collect_unordered();
+
+    check_iterators(l);
+    check_empty_list(empty);
+}
+
+TEST_F(ForwardList, CollectorNoShards)
+{
+    forward_list2_collector<int> collector(0);
+    auto l1 = collector.collect();
+    auto l2 = collector.collect_unordered();
+
+    check_empty_list(l1);
+    check_empty_list(l2);
+}
+
+TEST_F(ForwardList, Segments)
+{
+    forward_list2<int> l;
+    int counter = 0;
+    l.generate_back(100, [&counter](){ return ++counter; });
+
+    for (std::size_t count = 1; count <= 8; ++count) {
+        auto bounds = forward_list2_segments(l.begin(), l.end(), count);
+        EXPECT_LE(bounds.size(), 2 * count + 1);
+        EXPECT_EQ(bounds.front(), l.begin());
+        EXPECT_EQ(bounds.back(), l.end());
+        for (std::size_t i = 1; i + 1 < bounds.size(); ++i)
+            EXPECT_EQ(std::distance(bounds[i - 1], bounds[i]), std::distance(bounds[0], bounds[1]));
+    }
+}
+
+TEST_F(ForwardList, ParallelTransform)
+{
+    forward_list2<int> l;
+    int counter = 0;
+    l.generate_back(1000, [&counter](){ return ++counter; });
+    parallel_transform_inplace(l, [](int x){ return x * 2; }, 4);
+
+    std::atomic<long> sum(0);
+    parallel_for_each(l, [&sum](int x){ sum += x; }, 3);
+
+    EXPECT_EQ(sum, 1000 * 1001);
+    EXPECT_EQ(parallel_count_if(l, [](int x){ return x % 4 == 0; }, 5), 500);
+    EXPECT_EQ(parallel_count_if(l, [](int x){ return x > 1000; }), 500);
+    EXPECT_EQ(l.back(), 2000);
+}
+
+TEST_F(ForwardList, ParallelBalance)
+{
+    forward_list2<int> l;
+    l.emplace_back_n(150000, 1);
+
+    std::vector<std::ptrdiff_t> shares(8);
+    forward_list2_parallel_segments(l.cbegin(), l.cend(), shares.size(),
+        [&shares](forward_list2<int>::const_iterator first, forward_list2<int>::const_iterator last, std::size_t worker) {
+            shares[worker] = std::distance(first, last);
+        });
+
+    std::ptrdiff_t total = 0;
+    for (auto share : shares)
+        total += share;
+    EXPECT_EQ(total, 150000);
+    EXPECT_LE(*std::max_element(shares.begin(), shares.end()), 150000 / 8 * 5 / 4);
+}
+
+TEST_F(ForwardList, ParallelSmall)
+{
+    forward_list2<int> l{ 1, 2, 3 };
+    parallel_transform_inplace(l, [](int x){ return x + 1; }, 8);
+    parallel_transform_inplace(l, [](int x){ return x - 1; }, 1);
+
+    check_ranged_list(l, 3);
+    EXPECT_EQ(parallel_count_if(l, [](int){ return true; }, 8), 3);
+}
+
+TEST_F(ForwardList, ParallelEmpty)
+{
+    forward_list2<int> l;
+    parallel_for_each(l, [](int){ throw std::runtime_error("unexpected call"); }, 4);
+
+    EXPECT_EQ(parallel_count_if(l, [](int){ return true; }, 4), 0);
+    check_empty_list(l);
+}
+
+TEST_F(ForwardList, ParallelException)
+{
+    forward_list2<int> l;
+    int counter = 0;
+    l.generate_back(100, [&counter](){ return ++counter; });
+
+    EXPECT_THROW(parallel_for_each(l, [](int x){ if (x == 77) throw std::runtime_error("77"); }, 4), std::runtime_error);
+}
+
+TEST_F(ForwardList, TrackingAllocator)
+{
+    using allocator = forward_list2_tracking_allocator<int>;
+    forward_list2_allocation_stats stats;
+    forward_list2<int, allocator> l{ allocator(stats) };
+    for (int i = 0; i < 100; ++i)
+        l.push_back(i);
+
+    const auto node_size = stats.bytes_per_block();
+    EXPECT_GE(node_size, sizeof(int) + sizeof(void*));
+    EXPECT_EQ(stats.live_blocks(), 100);
+    EXPECT_EQ(stats.live_bytes(), 100 * node_size);
+    EXPECT_EQ(stats.live_footprint(), 100 * forward_list2_allocation_stats::footprint(node_size));
+    EXPECT_GT(stats.footprint_per_block(), node_size);
+
+    for (int i = 0; i < 60; ++i)
+        l.pop_front();
+
+    EXPECT_EQ(stats.live_blocks(), 40);
+    EXPECT_EQ(stats.live_bytes(), 40 * node_size);
+    EXPECT_EQ(stats.peak_bytes(), 100 * node_size);
+    EXPECT_EQ(stats.total_blocks(), 100);
+
+    l.clear();
+
+    EXPECT_EQ(stats.live_blocks(), 0);
+    EXPECT_EQ(stats.live_bytes(), 0);
+    EXPECT_EQ(stats.live_footprint(), 0);
+    EXPECT_EQ(stats.bytes_per_block(), 0);
+    EXPECT_EQ(stats.peak_bytes(), 100 * node_size);
+}
+
+struct tracking_tag;
+
+TEST_F(ForwardList, TrackingAllocatorTag)
+{
+    using list = forward_list2<int, forward_list2_tracking_allocator<int, std::allocator<int>, tracking_tag>>;
+    auto& stats = forward_list2_tag_stats<tracking_tag>();
+    {
+        list l1{ 1, 2, 3 };
+        list l2(10, 1);
+        auto l3 = l1;
+
+        EXPECT_EQ(stats.live_blocks(), 16);
+        EXPECT_EQ(stats.live_bytes(), 16 * stats.bytes_per_block());
+        EXPECT_EQ(l1.get_allocator(), l2.get_allocator());
+    }
+
+    EXPECT_EQ(stats.live_blocks(), 0);
+    EXPECT_EQ(stats.live_bytes(), 0);
+    EXPECT_EQ(stats.total_blocks(), 16);
+}
+
+TEST_F(ForwardList, AllocationFootprint)
+{
+    const auto granule = 2 * sizeof(void*);
+
+    EXPECT_EQ(forward_list2_allocation_stats::footprint(1), 2 * granule);
+    EXPECT_EQ(forward_list2_allocation_stats::footprint(2 * granule), 3 * granule);
+    EXPECT_EQ(forward_list2_allocation_stats::footprint(3 * granule - sizeof(void*)), 3 * granule);
+}
+
+TEST_F(ForwardList, CopyOnWrite)
+{
+    using allocator = forward_list2_tracking_allocator<int>;
+    forward_list2_allocation_stats stats;
+    cow_forward_list2<int, allocator> l1({ 1, 2, 3 }, allocator(stats));
+    auto l2 = l1;
+    cow_forward_list2<int, allocator> l3{ allocator(stats) };
+    l3 = l2;
+
+    EXPECT_EQ(stats.live_blocks(), 3);
+    EXPECT_EQ(&l1.get(), &l3.get());
+    EXPECT_TRUE(l1.shared());
+    EXPECT_EQ(l2.back(), 3);
+
+    l2.push_back(4);
+    EXPECT_EQ(stats.live_blocks(), 7);
+    EXPECT_EQ(l1.get(), (forward_list2<int, allocator>{ { 1, 2, 3 }, allocator(stats) }));
+    EXPECT_EQ(l2.back(), 4);
+    EXPECT_NE(l1, l2);
+    EXPECT_EQ(l1, l3);
+
+    // Not shared anymore, so no copy
+    l2.pop_front();
+    l2.mutate().reverse();
+    EXPECT_FALSE(l2.shared());
+    EXPECT_EQ(stats.live_blocks(), 6);
+    EXPECT_EQ(l2.front(), 4);
+    EXPECT_EQ(l2.back(), 2);
+
+    l1.clear();
+    EXPECT_TRUE(l1.empty());
+    EXPECT_EQ(l3.back(), 3);
+    EXPECT_EQ(stats.live_blocks(), 6);
+
+    l3.clear();
+    EXPECT_EQ(stats.live_blocks(), 3);
+}
+
+TEST_F(ForwardList, CopyOnWriteMove)
+{
+    cow_forward_list2<int> l1{ 1, 2, 3 };
+    auto l2 = std::move(l1);
+
+    EXPECT_EQ(l1, l2);
+    l1.emplace_front(0);
+    EXPECT_EQ(l1.front(), 0);
+    EXPECT_EQ(l2.front(), 1);
+
+    std::swap(l1, l2);
+    EXPECT_EQ(l1.front(), 1);
+    EXPECT_EQ(l2.front(), 0);
+}
+
+TEST_F(ForwardList, CopyOnWriteLazyTail)
+{
+    // Copy assignment leaves the tail unknown in the lazy mode
+    const forward_list2<int> source{ 1, 2, 3 };
+    forward_list2<int> assigned;
+    assigned = source;
+    cow_forward_list2<int> l(std::move(assigned));
+    l.mutate() = source;
+
+    // Copies share the list with the tail already found
+    auto snapshot = l;
+    tail_walk_steps = 0;
+    int back = 0;
+    std::thread reader([&snapshot, &back]() { back = snapshot.back(); });
+    EXPECT_EQ(l.back(), 3);
+    reader.join();
+
+    EXPECT_EQ(back, 3);
+    EXPECT_EQ(tail_walk_steps, 0);
+}
+
+TEST_F(ForwardList, CopyOnWriteThreads)
+{
+    cow_forward_list2<int> l{ 1, 2, 3, 4 };
+    int sum = 0;
+    std::thread reader;
+    {
+        auto snapshot = l;
+        reader = std::thread([snapshot, &sum]() {
+            for (int i : snapshot)
+                sum += i;
+        });
+    }
+
+    // Modified in place once the reader has dropped its snapshot
+    while (l.shared())
+        std::this_thread::yield();
+    const int* node = &*std::next(l.begin());
+    l.pop_front();
+    EXPECT_EQ(&l.front(), node);
+
+    reader.join();
+    EXPECT_EQ(sum, 10);
+}
+
+TEST_F(ForwardList, SortByKey)
+{
+    forward_list2<std::unique_ptr<int>> l;
+    for (int i : { 3, -1, 4, -1, 5, -9, 2, 6 })
+        l.emplace_back(new int(i));
+    std::vector<const int*> addresses;
+    for (const auto& p : l)
+        addresses.push_back(p.get());
+
+    int calls = 0;
+    l.sort_by_key([&calls](const std::unique_ptr<int>& p) { ++calls; return std::abs(*p); });
+
+    EXPECT_EQ(calls, 8);
+    std::vector<int> values;
+    for (const auto& p : l)
+        values.push_back(*p);
+    EXPECT_EQ(values, (std::vector<int>{ -1, -1, 2, 3, 4, 5, 6, -9 }));
+    // Equal keys keep their order, elements stay in their nodes
+    EXPECT_EQ(l.front().get(), addresses[1]);
+    EXPECT_EQ(std::next(l.begin())->get(), addresses[3]);
+    EXPECT_EQ(l.back().get(), addresses[5]);
+    EXPECT_EQ(std::next(l.before_end()), l.end());
+
+    l.sort_by_key([](const std::unique_ptr<int>& p) { return *p; }, std::greater<int>());
+    EXPECT_EQ(*l.front(), 6);
+    EXPECT_EQ(*l.back(), -9);
+    l.emplace_back(new int(0));
+    EXPECT_EQ(*l.back(), 0);
+}
+
+TEST_F(ForwardList, SortByKeyShort)
+{
+    forward_list2<int> l;
+    l.sort_by_key([](int i) { return -i; });
+    check_empty_list(l);
+
+    l.push_back(1);
+    l.sort_by_key([](int i) { return -i; });
+    check_ranged_list(l, 1);
+}
+
+TEST_F(ForwardList, SortException)
+{
+    forward_list2<int> l{ 2, 4, 6, 8, 10, 1, 3, 5, 7, 9 };
+    int budget = 10;
+    auto throwing_less = [&budget](int x, int y) {
+        if (--budget == 0)
+            throw std::runtime_error("comparison");
+        return x < y;
+    };
+
+    EXPECT_THROW(l.sort(throwing_less), std::runtime_error);
+    EXPECT_EQ(std::next(l.before_end()), l.end());
+    l.sort();
+    check_ranged_list(l, 10);
+}
+
+TEST_F(ForwardList, ArraySort)
+{
+    forward_list2<int> l{ 5, 3, 9, 1, 7, 2, 8, 4, 6, 10 };
+    l.sort(forward_list2_array_sort);
+    check_ranged_list(l, 10);
+
+    forward_list2<int>::sort_buffer buffer;
+    l.sort(forward_list2_array_sort, std::greater<int>(), buffer);
+    EXPECT_EQ(l.front(), 10);
+    EXPECT_EQ(l.back(), 1);
+    EXPECT_GE(buffer.capacity(), 10);
+
+    const auto capacity = buffer.capacity();
+    buffer.reserve(5);
+    EXPECT_EQ(buffer.capacity(), capacity);
+
+    l.sort(forward_list2_array_sort, std::less<int>(), buffer);
+    check_ranged_list(l, 10);
+
+    forward_list2<int> empty;
+    empty.sort(forward_list2_array_sort);
+    check_empty_list(empty);
+}
+
+TEST_F(ForwardList, ArraySortException)
+{
+    forward_list2<int> l{ 5, 3, 9, 1, 7, 2, 8, 4, 6, 10 };
+    int budget = 10;
+    auto throwing_less = [&budget](int x, int y) {
+        if (--budget == 0)
+            throw std::runtime_error("comparison");
+        return x < y;
+    };
+
+    EXPECT_THROW(l.sort(forward_list2_array_sort, throwing_less), std::runtime_error);
+    l.sort();
+    check_ranged_list(l, 10);
+}
+
+TEST_F(ForwardList, UniqueUnsorted)
+{
+    forward_list2<int> l{ 3, 1, 3, 2, 1, 1, 4, 2, 5, 4 };
+    EXPECT_EQ(l.unique_unsorted(), 5);
+    EXPECT_EQ(l, (forward_list2<int>{ 3, 1, 2, 4, 5 }));
+    EXPECT_EQ(l.back(), 5);
+    l.push_back(6);
+    EXPECT_EQ(std::next(l.before_end()), l.end());
+
+    forward_list2<int> empty;
+    EXPECT_EQ(empty.unique_unsorted(), 0);
+    check_empty_list(empty);
+}
+
+TEST_F(ForwardList, UniqueUnsortedLarge)
+{
+    forward_list2<int> l;
+    for (int i = 0; i < 10000; ++i)
+        l.push_back((i * 7919) % 1000);
+
+    EXPECT_EQ(l.unique_unsorted(), 9000);
+    int count = 0;
+    for (auto it = l.begin(); it != l.end(); ++it, ++count)
+        EXPECT_EQ(*it, (count * 7919) % 1000);
+    EXPECT_EQ(count, 1000);
+    EXPECT_EQ(l.back(), (999 * 7919) % 1000);
+}
+
+TEST_F(ForwardList, UniqueUnsortedPredicate)
+{
+    forward_list2<std::string> l{ "b", "aa", "c", "bb", "ccc", "ddd" };
+    auto length = [](const std::string& s) { return s.size(); };
+    auto same_length = [](const std::string& x, const std::string& y) { return x.size() == y.size(); };
+
+    EXPECT_EQ(l.unique_unsorted(length, same_length), 3);
+    EXPECT_EQ(l, (forward_list2<std::string>{ "b", "aa", "ccc" }));
+    EXPECT_EQ(l.back(), "ccc");
+}
+
+TEST_F(ForwardList, SetUnion)
+{
+    forward_list2<int> l1{ 1, 2, 2, 4, 6, 8 };
+    forward_list2<int> l2{ 2, 3, 4, 5, 9, 10 };
+    const int* node = &l2.back();
+    forward_list2<int> result{ 0 };
+    l1.set_union_into(l2, result);
+
+    EXPECT_EQ(result, (forward_list2<int>{ 0, 1, 2, 2, 3, 4, 5, 6, 8, 9, 10 }));
+    EXPECT_EQ(&result.back(), node);
+    check_empty_list(l1);
+    check_empty_list(l2);
+
+    forward_list2<int> l3{ 10, 5, 1 };
+    forward_list2<int> l4{ 7 };
+    forward_list2<int> result2;
+    l3.set_union_into(l4, result2, std::greater<int>());
+    EXPECT_EQ(result2, (forward_list2<int>{ 10, 7, 5, 1 }));
+    EXPECT_EQ(result2.back(), 1);
+}
+
+TEST_F(ForwardList, SetIntersection)
+{
+    forward_list2<int> l1{ 1, 2, 2, 4, 6, 8 };
+    forward_list2<int> l2{ 2, 2, 3, 4, 5, 9, 10 };
+    const int* node = &*std::next(l1.begin());
+    forward_list2<int> result;
+    l1.set_intersection_into(l2, result);
+
+    EXPECT_EQ(result, (forward_list2<int>{ 2, 2, 4 }));
+    EXPECT_EQ(&result.front(), node);
+    EXPECT_EQ(result.back(), 4);
+    check_empty_list(l1);
+    check_empty_list(l2);
+
+    forward_list2<int> l3{ 1, 3 };
+    forward_list2<int> l4{ 2 };
+    l3.set_intersection_into(l4, result);
+    EXPECT_EQ(result.back(), 4);
+    check_empty_list(l3);
+}
+
+TEST_F(ForwardList, SetDifference)
+{
+    forward_list2<int> l1{ 1, 2, 2, 4, 6, 8 };
+    forward_list2<int> l2{ 2, 3, 4, 5 };
+    forward_list2<int> result;
+    l1.set_difference_into(l2, result);
+
+    EXPECT_EQ(result, (forward_list2<int>{ 1, 2, 6, 8 }));
+    EXPECT_EQ(result.back(), 8);
+    check_empty_list(l1);
+    check_empty_list(l2);
+
+    forward_list2<int> l3{ 1, 2, 3 };
+    forward_list2<int> l4{ 3 };
+    result.clear();
+    l3.set_difference_into(l4, result);
+    check_ranged_list(result, 2);
+}
+
+TEST_F(ForwardList, RotateFrontToBack)
+{
+    forward_list2<int> l{ 2, 3, 4, 1 };
+    const int* node = &l.front();
+    l.rotate_front_to_back();
+    EXPECT_EQ(l, (forward_list2<int>{ 3, 4, 1, 2 }));
+    EXPECT_EQ(&l.back(), node);
+
+    l.rotate_front_to_back();
+    l.rotate_front_to_back();
+    check_ranged_list(l, 4);
+
+    forward_list2<int> single{ 1 };
+    single.rotate_front_to_back();
+    check_ranged_list(single, 1);
+
+    forward_list2<int> empty;
+    empty.rotate_front_to_back();
+    check_empty_list(empty);
+    EXPECT_EQ(empty.before_end(), empty.before_begin());
+    empty.push_back(1);
+    check_ranged_list(empty, 1);
+}
+
+TEST_F(ForwardList, MoveToBack)
+{
+    forward_list2<int> l{ 1, 2, 5, 3, 4 };
+    l.move_to_back(std::next(l.begin()));
+    check_ranged_list(l, 5);
+
+    // Nothing follows the tail
+    l.move_to_back(l.before_end());
+    check_ranged_list(l, 5);
+
+    l.move_to_back(std::next(l.begin(), 3));
+    check_ranged_list(l, 5);
+}
+
+TEST_F(ForwardList, RotateAfter)
+{
+    forward_list2<int> l{ 4, 5, 1, 2, 3 };
+    l.rotate_after(std::next(l.begin()));
+    check_ranged_list(l, 5);
+
+    l.rotate_after(l.before_begin());
+    check_ranged_list(l, 5);
+    l.rotate_after(l.before_end());
+    check_ranged_list(l, 5);
+
+    l.rotate_after(std::next(l.begin(), 3));
+    EXPECT_EQ(l, (forward_list2<int>{ 5, 1, 2, 3, 4 }));
+    EXPECT_EQ(l.back(), 4);
+}
+
+TEST_F(ForwardList, ClearIncremental)
+{
+    forward_list2<int> l{ 1, 2, 3, 4, 5 };
+    EXPECT_FALSE(l.clear_incremental(2));
+    EXPECT_EQ(l.front(), 3);
+    EXPECT_EQ(l.back(), 5);
+    EXPECT_TRUE(l.clear_incremental(3));
+    check_empty_list(l);
+    EXPECT_TRUE(l.clear_incremental(3));
+
+    l.push_back(1);
+    check_ranged_list(l, 1);
+}
+
+TEST_F(ForwardList, ClearAsync)
+{
+    using allocator = forward_list2_tracking_allocator<int>;
+    forward_list2_allocation_stats stats;
+    {
+        forward_list2_reclaimer<int, allocator> reclaimer;
+        for (int i = 0; i < 10; ++i) {
+            forward_list2<int, allocator> l{ allocator(stats) };
+            l.generate_back(1000, [i]() { return i; });
+            clear_async(l, reclaimer);
+            EXPECT_TRUE(l.empty());
+            EXPECT_EQ(l.before_end(), l.before_begin());
+
+            l.push_back(1);
+            EXPECT_EQ(l.front(), 1);
+            EXPECT_EQ(l.back(), 1);
+        }
+    }
+
+    EXPECT_EQ(stats.live_blocks(), 0);
+    EXPECT_EQ(stats.total_blocks(), 10 * 1001);
+}
+
+TEST_F(ForwardList, ClearDeferred)
+{
+    using allocator = forward_list2_tracking_allocator<int>;
+    using reclaimer_type = forward_list2_reclaimer<int, allocator>;
+    forward_list2_allocation_stats stats;
+    reclaimer_type reclaimer(reclaimer_type::mode::deferred);
+    forward_list2<int, allocator> l({ 1, 2, 3 }, allocator(stats));
+
+    clear_async(l, reclaimer);
+    reclaimer.retire(forward_list2<int, allocator>({ 4, 5 }, allocator(stats)));
+    EXPECT_TRUE(l.empty());
+    EXPECT_EQ(l.before_end(), l.before_begin());
+    EXPECT_EQ(stats.live_blocks(), 5);
+
+    reclaimer.drain();
+    EXPECT_EQ(stats.live_blocks(), 0);
+}
+
+TEST_F(ForwardList, WorkStealing)
+{
+    work_stealing_forward_list2<int> queues(3);
+    for (int i = 1; i <= 5; ++i)
+        queues.push_back(0, i);
+
+    // Worker 1 steals 1, 2, 3 and keeps 2, 3
+    int value = 0;
+    EXPECT_TRUE(queues.try_pop(1, value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(queues.try_pop(0, value));
+    EXPECT_EQ(value, 4);
+    EXPECT_TRUE(queues.try_pop(1, value));
+    EXPECT_EQ(value, 2);
+
+    // Worker 2 steals the rest of worker 0 first
+    EXPECT_TRUE(queues.try_pop(2, value));
+    EXPECT_EQ(value, 5);
+    EXPECT_TRUE(queues.try_pop(2, value));
+    EXPECT_EQ(value, 3);
+    EXPECT_FALSE(queues.try_pop(0, value));
+    EXPECT_FALSE(queues.try_pop(2, value));
+}
+
+TEST_F(ForwardList, WorkStealingThreads)
+{
+    const int workers = 4;
+    const long tasks = 6000;
+    work_stealing_forward_list2<int> queues(workers);
+    for (int i = 1; i <= tasks; ++i)
+        queues.push_back(0, i);
+
+    // Even tasks spawn one more task on the same worker
+    std::atomic<long> pending{ tasks + tasks / 2 };
+    std::atomic<long> sum{ 0 };
+    auto work = [&](int worker) {
+        int value;
+        while (pending.load() > 0) {
+            if (!queues.try_pop(worker, value))
+                continue;
+            if (value > 0 && value % 2 == 0)
+                queues.push_back(worker, -value);
+            sum += value;
+            --pending;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < workers; ++i)
+        threads.emplace_back(work, i);
+    work(0);
+    for (auto& t : threads)
+        t.join();
+
+    EXPECT_EQ(sum.load(), tasks * (tasks + 1) / 2 - (tasks / 2) * (tasks / 2 + 1));
+    int value;
+    EXPECT_FALSE(queues.try_pop(0, value));
+}
+
+TEST_F(ForwardList, SingleProducerSingleConsumer)
+{
+    using allocator = forward_list2_tracking_allocator<std::string>;
+    forward_list2_allocation_stats stats;
+    {
+        spsc_forward_list2<std::string, allocator> q{ allocator(stats) };
+        std::string value;
+        EXPECT_TRUE(q.empty());
+        EXPECT_FALSE(q.try_pop(value));
+
+        q.push_back("a");
+        q.emplace_back(2, 'b');
+        EXPECT_FALSE(q.empty());
+        EXPECT_TRUE(q.try_pop(value));
+        EXPECT_EQ(value, "a");
+        EXPECT_TRUE(q.try_pop(value));
+        EXPECT_EQ(value, "bb");
+        EXPECT_TRUE(q.empty());
+
+        // Popped nodes are reused
+        const auto blocks = stats.total_blocks();
+        for (int i = 0; i < 100; ++i) {
+            q.push_back(std::to_string(i));
+            q.push_back(std::to_string(i));
+            EXPECT_TRUE(q.try_pop(value));
+            EXPECT_TRUE(q.try_pop(value));
+            EXPECT_EQ(value, std::to_string(i));
+        }
+        EXPECT_EQ(stats.total_blocks(), blocks);
+
+        q.push_back("left");
+    }
+    EXPECT_EQ(stats.live_blocks(), 0);
+}
+
+TEST_F(ForwardList, SingleProducerSingleConsumerThreads)
+{
+    const int count = 100000;
+    spsc_forward_list2<int> q;
+    std::thread producer([&q]() {
+        for (int i = 0; i < count; ++i)
+            q.push_back(i);
+    });
+
+    int expected = 0;
+    while (expected < count) {
+        int value;
+        if (!q.try_pop(value))
+            continue;
+        EXPECT_EQ(value, expected);
+        ++expected;
+    }
+    producer.join();
+    EXPECT_TRUE(q.empty());
+}
+
+TEST_F(ForwardList, Arena)
+{
+    forward_list2_arena_options options;
+    options.chunk_size = 4096;
+    options.huge_pages = false;
+    forward_list2_arena arena(options);
+    using allocator = forward_list2_arena_allocator<int>;
+    forward_list2<int, allocator> l((allocator(arena)));
+
+    l.generate_back(1000, [&l]() { return l.empty() ? 1000 : l.back() - 1; });
+    l.sort(forward_list2_array_sort);
+    int expected = 0;
+    for (int i : l)
+        EXPECT_EQ(i, ++expected);
+    EXPECT_EQ(l.back(), 1000);
+
+    // Freed nodes are reused
+    const auto chunks = arena.chunks();
+    EXPECT_GT(chunks, 1);
+    l.clear();
+    l.emplace_back_n(1000, 1);
+    EXPECT_EQ(arena.chunks(), chunks);
+    EXPECT_EQ(arena.chunks(forward_list2_arena::backing::hugetlb), 0);
+    EXPECT_EQ(arena.chunks(forward_list2_arena::backing::transparent_huge_pages), 0);
+    EXPECT_TRUE(arena.numa_bound());
+
+    forward_list2<int, allocator> other((allocator(arena)));
+    EXPECT_EQ(l.get_allocator(), other.get_allocator());
+}
+
+TEST_F(ForwardList, ArenaTinyChunks)
+{
+    // Chunks smaller than a page are enlarged, so every block fits
+    forward_list2_arena_options options;
+    options.chunk_size = 8;
+    options.huge_pages = false;
+    forward_list2_arena arena(options);
+    forward_list2<int, forward_list2_arena_allocator<int>> l((forward_list2_arena_allocator<int>(arena)));
+    l.emplace_back_n(1000, 1);
+
+    EXPECT_EQ(l.back(), 1);
+    EXPECT_LE(arena.chunks(), 16);
+}
+
+TEST_F(ForwardList, ArenaHugePages)
+{
+    // Whatever the system supports, the arena falls back to something which works
+    forward_list2_arena_options options;
+    options.chunk_size = 1;
+    options.numa_node = 0;
+    forward_list2_arena arena(options);
+    forward_list2<std::string, forward_list2_arena_allocator<std::string>> l((forward_list2_arena_allocator<std::string>(arena)));
+    for (int i = 0; i < 10000; ++i)
+        l.push_back(std::to_string(i));
+
+    EXPECT_EQ(l.back(), "9999");
+    EXPECT_GE(arena.chunks(), 1);
+}
+
+TEST_F(ForwardList, MutableBack)
+{
+    forward_list2<std::unique_ptr<int>> l;
+    l.emplace_back(new int(1));
+    l.emplace_back(new int(2));
+    *l.back() = 3;
+    auto p = std::move(l.back());
+
+    EXPECT_EQ(*p, 3);
+    EXPECT_EQ(l.back(), nullptr);
+    EXPECT_EQ(std::next(l.before_end()), l.end());
+}
+
+TEST_F(ForwardList, MutableBackNonMovable)
+{
+    forward_list2<std::atomic<int>> l;
+    l.emplace_back(1);
+    l.emplace_back(2);
+    l.back().store(3);
+
+    EXPECT_EQ(l.front().load(), 1);
+    EXPECT_EQ(as_const(l).back().load(), 3);
+}
+
+TEST_F(ForwardList, Queue)
+{
+    forward_list2_queue<int> q;
+    for (int i = 1; i <= 10; ++i)
+        q.push(i);
+    q.emplace(11);
+    q.back() = 12;
+
+    EXPECT_EQ(q.size(), 11);
+    EXPECT_EQ(q.front(), 1);
+    EXPECT_EQ(q.back(), 12);
+
+    auto copy = q;
+    for (int i = 1; i <= 10; ++i) {
+        EXPECT_EQ(q.front(), i);
+        q.pop();
+    }
+
+    EXPECT_EQ(q.size(), 1);
+    EXPECT_EQ(q.front(), 12);
+    EXPECT_TRUE(copy < q);
+
+    q.swap(copy);
+    EXPECT_EQ(q.size(), 11);
+    EXPECT_EQ(copy.size(), 1);
+
+    q = std::move(copy);
+    EXPECT_EQ(q.size(), 1);
+    EXPECT_EQ(q.back(), 12);
+}
+
+TEST_F(ForwardList, QueueMoveOnly)
+{
+    std::queue<std::unique_ptr<int>, sized_forward_list2<std::unique_ptr<int>>> q;
+    q.push(std::unique_ptr<int>(new int(1)));
+    q.push(std::unique_ptr<int>(new int(2)));
+    auto p = std::move(q.back());
+    q.pop();
+
+    EXPECT_EQ(*p, 2);
+    EXPECT_EQ(q.size(), 1);
+    EXPECT_EQ(q.front(), nullptr);
+}
+
+#ifdef __linux__
+// Self-relative pointer: stores the distance from itself to the target,
+// so it stays valid in a memory region mapped at different addresses
+template<typename T>
+class offset_ptr
+{
+public:
+    using element_type      = T;
+    using value_type        = typename std::remove_cv<T>::type;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = T&;
+    using pointer           = offset_ptr;
+    using iterator_category = std::random_access_iterator_tag;
+
+    offset_ptr() noexcept { set(nullptr); }
+    offset_ptr(std::nullptr_t) noexcept { set(nullptr); }
+    offset_ptr(T* p) noexcept { set(p); }
+    offset_ptr(const offset_ptr& other) noexcept { set(other.get()); }
+
+    template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    offset_ptr(const offset_ptr<U>& other) noexcept { set(other.get()); }
+
+    offset_ptr& operator=(const offset_ptr& other) noexcept { set(other.get()); return *this; }
+
+    static offset_ptr pointer_to(T& r) noexcept { return offset_ptr(std::addressof(r)); }
+
+    T* get() const noexcept
+    {
+        return m_offset == 1 ? nullptr : reinterpret_cast<T*>(reinterpret_cast<std::intptr_t>(this) + m_offset);
+    }
+
+    T* operator->() const noexcept { return get(); }
+    T& operator*() const noexcept { return *get(); }
+    explicit operator bool() const noexcept { return get() != nullptr; }
+
+    friend bool operator==(const offset_ptr& lhs, const offset_ptr& rhs) noexcept { return lhs.get() == rhs.get(); }
+    friend bool operator!=(const offset_ptr& lhs, const offset_ptr& rhs) noexcept { return lhs.get() != rhs.get(); }
+
+private:
+    void set(T* p) noexcept
+    {
+        // 1 is never a distance to a suitably aligned object
+        m_offset = p == nullptr ? 1 : reinterpret_cast<std::intptr_t>(p) - reinterpret_cast<std::intptr_t>(this);
+    }
+
+    std::intptr_t m_offset;
+};
+
+// Bump allocator over a shared memory region, its state is kept in the region
+struct shm_arena
+{
+    std::atomic<std::size_t> used;
+    std::size_t capacity;
+
+    static shm_arena* create(std::size_t capacity)
+    {
+        int fd = memfd_create("forward_list2", 0);
+        if (fd < 0 || ftruncate(fd, capacity) != 0)
+            return nullptr;
+
+        void* memory = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (memory == MAP_FAILED)
+            return nullptr;
+
+        auto arena = new (memory) shm_arena;
+        arena->used = sizeof(shm_arena);
+        arena->capacity = capacity;
+        return arena;
+    }
+
+    static void destroy(shm_arena* arena)
+    {
+        munmap(arena, arena->capacity);
+    }
+
+    void* allocate(std::size_t bytes)
+    {
+        bytes = (bytes + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+        auto offset = used.fetch_add(bytes);
+        if (offset + bytes > capacity)
+            throw std::bad_alloc();
+        return reinterpret_cast<char*>(this) + offset;
+    }
+};
+
+template<typename T>
+struct shm_allocator
+{
+    using value_type = T;
+    using pointer    = offset_ptr<T>;
+
+    explicit shm_allocator(shm_arena* a) noexcept : arena(a) { }
+
+    template<typename U>
+    shm_allocator(const shm_allocator<U>& other) noexcept : arena(other.arena) { }
+
+    pointer allocate(std::size_t n) { return pointer(static_cast<T*>(arena->allocate(n * sizeof(T)))); }
+    void deallocate(pointer, std::size_t) noexcept { }
+
+    friend bool operator==(const shm_allocator& lhs, const shm_allocator& rhs) noexcept { return lhs.arena == rhs.arena; }
+    friend bool operator!=(const shm_allocator& lhs, const shm_allocator& rhs) noexcept { return lhs.arena != rhs.arena; }
+
+    shm_arena* arena;
+};
+
+TEST_F(ForwardList, SharedMemory)
+{
+    using list = forward_list2<int, shm_allocator<int>>;
+    static_assert(std::is_same<list::pointer, offset_ptr<int>>::value, "offset_ptr must be used");
+
+    auto arena = shm_arena::create(1 << 16);
+    ASSERT_NE(arena, nullptr);
+
+    auto l = new (arena->allocate(sizeof(list))) list(shm_allocator<int>(arena));
+    for (int i = 1; i <= 3; ++i)
+        l->push_back(i);
+
+    // The reader consumes the front element and appends to the back in the shared list
+    auto pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        bool ok = l->front() == 1 && l->back() == 3;
+        l->pop_front();
+        l->push_back(4);
+        _exit(ok ? 0 : 1);
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    EXPECT_EQ(*l, (list({ 2, 3, 4 }, shm_allocator<int>(arena))));
+    EXPECT_EQ(l->back(), 4);
+    EXPECT_EQ(std::next(l->before_end()), l->end());
+
+    l->splice_after(l->before_end(), *l, l->before_begin());
+    EXPECT_EQ(l->back(), 2);
+
+    l->~list();
+    shm_arena::destroy(arena);
+}
+#endif
+
+struct operation_counters
+{
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+    std::size_t comparisons = 0;
+};
+
+static operation_counters counters;
+
+template<typename T>
+struct counting_allocator
+{
+    using value_type = T;
+
+    counting_allocator() = default;
+
+    template<typename U>
+    counting_allocator(const counting_allocator<U>&) noexcept { }
+
+    T* allocate(std::size_t n)
+    {
+        ++counters.allocations;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        ++counters.deallocations;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    friend bool operator==(const counting_allocator&, const counting_allocator&) noexcept { return true; }
+    friend bool operator!=(const counting_allocator&, const counting_allocator&) noexcept { return false; }
+};
+
+struct counting_less
+{
+    bool operator()(int x, int y) const
+    {
+        ++counters.comparisons;
+        return x < y;
+    }
+};
+
+using counted_list = forward_list2<int, counting_allocator<int>>;
+
+class Complexity : public ::testing::TestWithParam<int>
+{
+protected:
+    void SetUp() override { reset(); }
+
+    static void reset()
+    {
+        counters = operation_counters();
+        tail_walk_steps = 0;
+    }
+
+    static counted_list make_list(int size, int step = 1)
+    {
+        counted_list l;
+        for (int i = 0; i < size; ++i)
+            l.push_back((i * step) % size);
+
+        reset();
+        return l;
+    }
+
+    // Step around 0.618 * size which visits all the numbers in make_list
+    static int coprime_step(int size)
+    {
+        int step = size * 618 / 1000;
+        while (gcd(step, size) != 1)
+            ++step;
+        return step;
+    }
+
+    static int gcd(int x, int y)
+    {
+        return y == 0 ? x : gcd(y, x % y);
+    }
+
+    static std::size_t log2(std::size_t n)
+    {
+        std::size_t result = 0;
+        for (; n > 1; n = (n + 1) / 2)
+            ++result;
+        return result;
+    }
+
+    // Number of tail walk steps for copy assignment and sorting
+    static std::size_t reorder_steps(int size)
+    {
+        return FORWARD_LIST2_LAZY_LAST ? 0 : size;
+    }
+};
+
+TEST_P(Complexity, PushBack)
+{
+    const int size = GetParam();
+    counted_list l;
+    for (int i = 0; i < size; ++i)
+        l.push_back(i);
+    l.emplace_back(size);
+
+    EXPECT_EQ(counters.allocations, size + 1);
+    EXPECT_EQ(counters.deallocations, 0);
+    EXPECT_EQ(tail_walk_steps, 0);
+    EXPECT_EQ(l.back(), size);
+}
+
+TEST_P(Complexity, Copy)
+{
+    const int size = GetParam();
+    auto l1 = make_list(size);
+    auto l2 = l1;
+
+    EXPECT_EQ(counters.allocations, size);
+    EXPECT_EQ(tail_walk_steps, 0);
+    EXPECT_EQ(l2, l1);
+}
+
+TEST_P(Complexity, CopyAssign)
+{
+    const int size = GetParam();
+    auto l1 = make_list(size);
+    counted_list l2;
+    l2 = l1;
+
+    EXPECT_EQ(counters.allocations, size);
+    EXPECT_EQ(tail_walk_steps, reorder_steps(size));
+    EXPECT_EQ(l2.back(), l1.back());
+    EXPECT_EQ(tail_walk_steps, size);
+}
+
+TEST_P(Complexity, Move)
+{
+    const int size = GetParam();
+    auto l1 = make_list(size);
+    auto l2 = std::move(l1);
+    l1 = std::move(l2);
+    l2.swap(l1);
+
+    EXPECT_EQ(counters.allocations, 0);
+    EXPECT_EQ(counters.deallocations, 0);
+    EXPECT_EQ(tail_walk_steps, 0);
+    EXPECT_EQ(l2.back(), size - 1);
+}
+
+TEST_P(Complexity, RoundRobin)
+{
+    const int size = GetParam();
+    auto l = make_list(size);
+    for (int i = 0; i < 3 * size + 1; ++i)
+        l.rotate_front_to_back();
+
+    EXPECT_EQ(counters.allocations, 0);
+    EXPECT_EQ(counters.deallocations, 0);
+    EXPECT_EQ(tail_walk_steps, 0);
+    EXPECT_EQ(l.front(), 1);
+    EXPECT_EQ(l.back(), 0);
+}
+
+TEST_P(Complexity, StablePartition)
+{
+    const int size = GetParam();
+    auto l = make_list(size);
+    int calls = 0;
+    auto it = l.stable_partition([&calls](int i) { ++calls; return i % 2 == 1; });
+
+    EXPECT_EQ(calls, size);
+    EXPECT_EQ(counters.allocations, 0);
+    EXPECT_EQ(counters.deallocations, 0);
+    EXPECT_EQ(tail_walk_steps, 0);
+    EXPECT_EQ(*it, size - 1);
+    EXPECT_EQ(l.front(), 1);
+    EXPECT_EQ(l.back(), size - 2);
+}
+
+TEST_P(Complexity, SpliceAfter)
+{
+    const int size = GetParam();
+    auto l1 = make_list(size);
+    auto l2 = make_list(size);
+    l1.splice_after(l1.before_end(), l2);
+    l2.splice_after(l2.before_begin(), l1, l1.before_begin());
+
+    EXPECT_EQ(counters.allocations, 0);
+    EXPECT_EQ(counters.deallocations, 0);
+    EXPECT_EQ(tail_walk_steps, 0);
+    EXPECT_EQ(l1.back(), size - 1);
+    EXPECT_EQ(l2.back(), 0);
+}
+
+TEST_P(Complexity, Merge)
+{
+    const int size = GetParam();
+    auto l1 = make_list(size);
+    auto l2 = make_list(size);
+    l1.merge(l2, counting_less());
+
+    // Two extra comparisons check if the lists overlap
+    EXPECT_LE(counters.comparisons, 2 * size + 1);
+    EXPECT_EQ(counters.allocations, 0);
+    EXPECT_EQ(counters.deallocations, 0);
+    EXPECT_EQ(tail_walk_steps, 0);
+    EXPECT_EQ(l1.back(), size - 1);
+}
+
+TEST_P(Complexity, MergeDisjoint)
+{
+    const int size = GetParam();
+    auto l = make_list(size);
+    l.merge(counted_list{ size, size + 1 }, counting_less());
+    l.merge(counted_list{ -2, -1 }, counting_less());
+
+    EXPECT_EQ(counters.comparisons, 3);
+    EXPECT_EQ(tail_walk_steps, 0);
+    EXPECT_EQ(l.front(), -2);
+    EXPECT_EQ(l.back(), size + 1);
+}
+
+TEST_P(Complexity, SetOperations)
+{
+    const int size = GetParam();
+    auto l1 = make_list(size);
+    auto l2 = make_list(size);
+    counted_list l3;
+    l2.remove_if([](int i) { return i % 2 == 0; });
+    reset();
+    l1.set_difference_into(l2, l3, counting_less());
+
+    EXPECT_LE(counters.comparisons, 2 * size);
+    EXPECT_EQ(counters.allocations, 0);
+    EXPECT_EQ(counters.deallocations, size);
+    EXPECT_EQ(tail_walk_steps, 0);
+    EXPECT_EQ(l3.back(), size - 2);
+}
+
+TEST_P(Complexity, Sort)
+{
+    const int size = GetParam();
+    auto l = make_list(size, coprime_step(size));
+    l.sort(counting_less());
+
+    // Run detection gives up after 32 runs
+    EXPECT_LE(counters.comparisons, size * log2(size) + 2 * 32);
+    EXPECT_EQ(counters.allocations, 0);
+    EXPECT_EQ(counters.deallocations, 0);
+    EXPECT_LE(tail_walk_steps, reorder_steps(size));
+    EXPECT_EQ(l.back(), size - 1);
+}
+
+TEST_P(Complexity, SortByKey)
+{
+    const int size = GetParam();
+    auto l = make_list(size, coprime_step(size));
+    int calls = 0;
+    l.sort_by_key([&calls](int i) { ++calls; return i; }, counting_less());
+
+    EXPECT_EQ(calls, size);
+    EXPECT_LE(counters.comparisons, size * log2(size) * 2);
+    // The arrays of keys and of detached nodes
+    EXPECT_EQ(counters.allocations, 2);
+    EXPECT_EQ(counters.deallocations, 2);
+    EXPECT_EQ(tail_walk_steps, 0);
+    EXPECT_EQ(l.back(), size - 1);
+}
+
+TEST_P(Complexity, ArraySort)
+{
+    const int size = GetParam();
+    counted_list::sort_buffer buffer;
+    buffer.reserve(size);
+    auto l = make_list(size, coprime_step(size));
+    l.sort(forward_list2_array_sort, counting_less(), buffer);
+
+    EXPECT_LE(counters.comparisons, size * log2(size) * 2);
+    EXPECT_EQ(counters.allocations, 0);
+    EXPECT_EQ(counters.deallocations, 0);
+    EXPECT_EQ(tail_walk_steps, 0);
+    EXPECT_EQ(l.back(), size - 1);
+}
+
+TEST_P(Complexity, SortSorted)
+{
+    const int size = GetParam();
+    auto l = make_list(size);
+    l.sort(counting_less());
+
+    EXPECT_EQ(counters.comparisons, size - 1);
+    EXPECT_EQ(tail_walk_steps, 0);
+    EXPECT_EQ(l.back(), size - 1);
+}
+
+TEST_P(Complexity, SortNearlySorted)
+{
+    const int size = GetParam();
+    auto l = make_list(size, 7);
+    l.sort(counting_less());
+
+    // 7 runs, each element takes part in 3 merges at most, and each of 6 merges
+    // may spend two comparisons to check if the lists overlap
+    EXPECT_LE(counters.comparisons, size - 1 + 3 * size + 2 * 6);
+    EXPECT_EQ(tail_walk_steps, 0);
+    EXPECT_EQ(l.back(), size - 1);
+    EXPECT_EQ(l.front(), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(Sizes, Complexity, ::testing::Values(10, 100, 1000));